@@ -3,23 +3,28 @@
 #include <string.h>
 #include <time.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 
 #include "../solver/cube_solver.h"
+#include "../solver/solver_cache.h"
+#include "../solver/cubie_cube.h"
+#include "../math/rng.h"
 #include "benchmark.h"
+#include "perf_counters.h"
 
-static void set_solved_cube(Scene* scene) {
+static void set_solved_cube(RGBColor (*cubeColors)[9]) {
     // White (U)
-    for (int i = 0; i < 9; i++) scene->cubeColors[FACE_IDX_TOP][i] = (RGBColor){1.0f, 1.0f, 1.0f};
+    for (int i = 0; i < 9; i++) cubeColors[FACE_IDX_TOP][i] = (RGBColor){1.0f, 1.0f, 1.0f};
     // Red (F)
-    for (int i = 0; i < 9; i++) scene->cubeColors[FACE_IDX_FRONT][i] = (RGBColor){1.0f, 0.0f, 0.0f};
+    for (int i = 0; i < 9; i++) cubeColors[FACE_IDX_FRONT][i] = (RGBColor){1.0f, 0.0f, 0.0f};
     // Blue (R)
-    for (int i = 0; i < 9; i++) scene->cubeColors[FACE_IDX_RIGHT][i] = (RGBColor){0.0f, 0.0f, 1.0f};
+    for (int i = 0; i < 9; i++) cubeColors[FACE_IDX_RIGHT][i] = (RGBColor){0.0f, 0.0f, 1.0f};
     // Orange (B)
-    for (int i = 0; i < 9; i++) scene->cubeColors[FACE_IDX_BACK][i] = (RGBColor){1.0f, 0.5f, 0.0f};
+    for (int i = 0; i < 9; i++) cubeColors[FACE_IDX_BACK][i] = (RGBColor){1.0f, 0.5f, 0.0f};
     // Green (L)
-    for (int i = 0; i < 9; i++) scene->cubeColors[FACE_IDX_LEFT][i] = (RGBColor){0.0f, 0.8f, 0.0f};
+    for (int i = 0; i < 9; i++) cubeColors[FACE_IDX_LEFT][i] = (RGBColor){0.0f, 0.8f, 0.0f};
     // Yellow (D)
-    for (int i = 0; i < 9; i++) scene->cubeColors[FACE_IDX_BOTTOM][i] = (RGBColor){1.0f, 1.0f, 0.0f};
+    for (int i = 0; i < 9; i++) cubeColors[FACE_IDX_BOTTOM][i] = (RGBColor){1.0f, 1.0f, 0.0f};
 }
 
 static size_t count_move_sequence(char** seq) {
@@ -29,6 +34,60 @@ static size_t count_move_sequence(char** seq) {
     return n;
 }
 
+// Монотонные часы: время сборки не зависит от перевода системных часов
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int compare_ns(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Перцентиль по ближайшему рангу из отсортированного массива
+static long long percentile_ns(const long long* sorted, int count, double p) {
+    int rank = (int)(p / 100.0 * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+static void print_latency_summary(long long* solve_ns, int runs) {
+    long long total = 0;
+    for (int r = 0; r < runs; ++r) total += solve_ns[r];
+    qsort(solve_ns, runs, sizeof(long long), compare_ns);
+
+    printf("Solve time (us): mean %.3f, p50 %.3f, p90 %.3f, p99 %.3f, p99.9 %.3f, max %.3f\n",
+           (double)total / runs / 1000.0,
+           percentile_ns(solve_ns, runs, 50.0) / 1000.0,
+           percentile_ns(solve_ns, runs, 90.0) / 1000.0,
+           percentile_ns(solve_ns, runs, 99.0) / 1000.0,
+           percentile_ns(solve_ns, runs, 99.9) / 1000.0,
+           solve_ns[runs - 1] / 1000.0);
+}
+
+// stage_ns[stage * runs + r]; порядок внутри этапа портится сортировкой
+static void print_stage_summary(long long* stage_ns, const long* stage_moves, const long long* solve_total, int runs) {
+    printf("Stages (choosing the stitched D turns counts only in the solve time):\n");
+    for (int stage = 0; stage < SOLVER_STAGE_COUNT; ++stage) {
+        long long* samples = stage_ns + (size_t)stage * runs;
+        long long total = 0;
+        for (int r = 0; r < runs; ++r) total += samples[r];
+        qsort(samples, runs, sizeof(long long), compare_ns);
+
+        printf("  %-10s mean %9.3f us (%5.1f%%), p50 %9.3f us, p99 %9.3f us, %+8.3f moves\n",
+               solver_stage_name((SolverStageId)stage),
+               (double)total / runs / 1000.0,
+               *solve_total > 0 ? 100.0 * total / *solve_total : 0.0,
+               percentile_ns(samples, runs, 50.0) / 1000.0,
+               percentile_ns(samples, runs, 99.0) / 1000.0,
+               (double)stage_moves[stage] / runs);
+    }
+}
+
 static void free_move_sequence(char** seq) {
     if (!seq) return;
     for (size_t i = 0; seq[i] != NULL; ++i) {
@@ -38,7 +97,7 @@ static void free_move_sequence(char** seq) {
 }
 
 
-static Move pick_move_like_gui(char excludeFace, char* outFaceChar) {
+static Move pick_move_like_gui(Rng* rng, char excludeFace, char* outFaceChar) {
     static const char* move_names[] = {
         "U", "U'", "U2",
         "D", "D'", "D2",
@@ -64,61 +123,553 @@ static Move pick_move_like_gui(char excludeFace, char* outFaceChar) {
         }
     }
 
-    int r = rand() % available_count;
+    int r = (int)rng_below(rng, (unsigned int)available_count);
     int idx = available_idx[r];
     if (outFaceChar) *outFaceChar = move_names[idx][0];
     return move_vals[idx];
 }
 
-int run_benchmark(int runs, int scramble_len, const char* csv_path, unsigned int seed, bool quiet) {
-    if (runs <= 0 || scramble_len < 0) return 1;
+static bool odd_permutation(const unsigned char* perm, int n) {
+    bool odd = false;
+    for (int i = 0; i < n; ++i) {
+        for (int j = i + 1; j < n; ++j) {
+            if (perm[i] > perm[j]) odd = !odd;
+        }
+    }
+    return odd;
+}
+
+static void shuffle(Rng* rng, unsigned char* perm, int n) {
+    for (int i = 0; i < n; ++i) perm[i] = (unsigned char)i;
+    for (int i = n - 1; i > 0; --i) {
+        int j = (int)rng_below(rng, (unsigned int)(i + 1));
+        unsigned char t = perm[i];
+        perm[i] = perm[j];
+        perm[j] = t;
+    }
+}
+
+/*
+    Равномерно случайное собираемое состояние: перестановки углов и рёбер
+    (Фишер-Йейтс), повороты 7 углов и перевороты 11 рёбер случайны, последние
+    дают в сумме 0. Если чётности перестановок разные, меняются местами два
+    последних ребра - это взаимно однозначно переводит нечётные случаи в
+    чётные, так что равномерность сохраняется.
+*/
+static void random_state_cube(Rng* rng, RGBColor (*cubeColors)[9]) {
+    CubieCube cube;
+    shuffle(rng, cube.cp, CUBIE_CORNER_COUNT);
+    shuffle(rng, cube.ep, CUBIE_EDGE_COUNT);
+    if (odd_permutation(cube.cp, CUBIE_CORNER_COUNT) != odd_permutation(cube.ep, CUBIE_EDGE_COUNT)) {
+        unsigned char t = cube.ep[CUBIE_EDGE_COUNT - 1];
+        cube.ep[CUBIE_EDGE_COUNT - 1] = cube.ep[CUBIE_EDGE_COUNT - 2];
+        cube.ep[CUBIE_EDGE_COUNT - 2] = t;
+    }
+
+    int twist = 0;
+    for (int i = 0; i < CUBIE_CORNER_COUNT - 1; ++i) {
+        cube.co[i] = (unsigned char)rng_below(rng, 3);
+        twist += cube.co[i];
+    }
+    cube.co[CUBIE_CORNER_COUNT - 1] = (unsigned char)((3 - twist % 3) % 3);
+
+    int flip = 0;
+    for (int i = 0; i < CUBIE_EDGE_COUNT - 1; ++i) {
+        cube.eo[i] = (unsigned char)rng_below(rng, 2);
+        flip ^= cube.eo[i];
+    }
+    cube.eo[CUBIE_EDGE_COUNT - 1] = (unsigned char)flip;
+
+    cubie_cube_to_colors(&cube, cubeColors);
+}
+
+// Скрамбл прогона run; moves (если не NULL) получает scramble_len ходов
+static void scramble_cube(RGBColor (*cubeColors)[9], unsigned int seed, int run, int scramble_len, Move* moves) {
+    // Свой поток у каждого прогона: скрамбл не зависит от того, какой поток и в каком порядке его решает
+    Rng rng;
+    rng_seed_stream(&rng, seed, (unsigned long long)run);
+    set_solved_cube(cubeColors);
+    if (scramble_len == BENCHMARK_RANDOM_STATE) {
+        random_state_cube(&rng, cubeColors);
+        return;
+    }
+
+    char lastFace = '\0';
+    for (int i = 0; i < scramble_len; ++i) {
+        char chosenFace = '\0';
+        Move m = pick_move_like_gui(&rng, lastFace, &chosenFace);
+        apply_move_to_cube_colors(cubeColors, m);
+        if (moves) moves[i] = m;
+        lastFace = chosenFace;
+    }
+}
+
+typedef struct {
+    size_t moves;
+    int cost;
+    bool solved;
+    long long solve_ns;
+    size_t heap_calls; // Верно только при одном потоке - счётчик кучи общий
+    SolverStageStats stages;
+    PerfSample perf; // Только с perf_counters
+} BenchRecord;
+
+#define BENCH_CHUNK 8
+
+typedef struct {
+    int runs;
+    int scramble_len;
+    unsigned int seed;
+    SolverOptions options;
+    SolverCache* cache; // Один кэш на все потоки, как в cube_solver_solve_batch
+    BenchRecord* records;
+    bool perf_counters;
+    atomic_int next; // Первый ещё не взятый прогон
+} BenchJob;
+
+// Прогоны раздаются порциями; запись идёт в records[run], так что порядок вывода от потоков не зависит
+static void* bench_worker(void* arg) {
+    BenchJob* job = arg;
+
+    SolverContext ctx;
+    solver_context_init(&ctx, &job->options);
+    ctx.log = NULL;
+    ctx.cache = job->cache;
+
+    // Счётчики считают только свой поток, поэтому у каждого рабочего свои
+    PerfCounters counters;
+    if (job->perf_counters) perf_counters_open(&counters);
+
+    for (;;) {
+        int start = atomic_fetch_add(&job->next, BENCH_CHUNK);
+        if (start >= job->runs) break;
+
+        int end = start + BENCH_CHUNK < job->runs ? start + BENCH_CHUNK : job->runs;
+        for (int r = start; r < end; ++r) {
+            RGBColor cubeColors[6][9];
+            CubeState state;
+            scramble_cube(cubeColors, job->seed, r, job->scramble_len, NULL);
+            cube_state_from_colors((const RGBColor (*)[9])cubeColors, &state);
+
+            // В замер входит только решатель: ходы пишутся в SolveResult, строк и кучи нет
+            BenchRecord* record = &job->records[r];
+            SolveResult result;
+            size_t heap_before = solver_heap_calls();
+            PerfSample perf_before;
+            if (job->perf_counters) perf_counters_read(&counters, &perf_before);
+            long long start_ns = now_ns();
+            cube_solver_solve_state(&ctx, &state, &result);
+            record->solve_ns = now_ns() - start_ns;
+            if (job->perf_counters) {
+                PerfSample perf_after;
+                perf_counters_read(&counters, &perf_after);
+                record->perf = perf_sample_diff(&perf_before, &perf_after);
+            }
+            record->heap_calls = solver_heap_calls() - heap_before;
+            int count = result.count > 0 ? result.count : 0;
+            record->moves = (size_t)count;
+            record->cost = solver_sequence_cost(&ctx.options, result.moves, count);
+            record->solved = result.solved;
+            record->stages = ctx.stage_stats;
+        }
+    }
+
+    if (job->perf_counters) perf_counters_close(&counters);
+    solver_context_destroy(&ctx);
+    return NULL;
+}
+
+// Средние по сборкам; счётчик, недоступный хоть в одном прогоне, не выводится
+static void print_perf_summary(const BenchRecord* records, int runs) {
+    double mean[PERF_COUNTER_COUNT];
+    bool available[PERF_COUNTER_COUNT];
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        long long total = 0;
+        available[i] = true;
+        for (int r = 0; r < runs; ++r) {
+            if (records[r].perf.values[i] < 0) {
+                available[i] = false;
+                break;
+            }
+            total += records[r].perf.values[i];
+        }
+        mean[i] = (double)total / runs;
+    }
+
+    printf("Perf counters per solve:");
+    bool any = false;
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        if (!available[i]) continue;
+        printf("%s %s %.0f", any ? "," : "", perf_counter_name((PerfCounterId)i), mean[i]);
+        any = true;
+    }
+    if (!any) {
+        printf(" unavailable (no hardware counters or perf_event_paranoid too strict)\n");
+        return;
+    }
+    if (available[PERF_COUNTER_CYCLES] && available[PERF_COUNTER_INSTRUCTIONS] && mean[PERF_COUNTER_CYCLES] > 0) {
+        printf(", IPC %.3f", mean[PERF_COUNTER_INSTRUCTIONS] / mean[PERF_COUNTER_CYCLES]);
+    }
+    if (available[PERF_COUNTER_INSTRUCTIONS] && mean[PERF_COUNTER_INSTRUCTIONS] > 0) {
+        if (available[PERF_COUNTER_CACHE_MISSES]) {
+            printf(", cache MPKI %.3f", 1000.0 * mean[PERF_COUNTER_CACHE_MISSES] / mean[PERF_COUNTER_INSTRUCTIONS]);
+        }
+        if (available[PERF_COUNTER_BRANCH_MISSES]) {
+            printf(", branch MPKI %.3f", 1000.0 * mean[PERF_COUNTER_BRANCH_MISSES] / mean[PERF_COUNTER_INSTRUCTIONS]);
+        }
+    }
+    printf("\n");
+}
+
+static void print_scrambles(int runs, int scramble_len, unsigned int seed) {
+    Move* moves = malloc(sizeof(Move) * (scramble_len > 0 ? scramble_len : 1));
+    if (!moves) return;
+
+    for (int r = 0; r < runs; ++r) {
+        if (scramble_len == BENCHMARK_RANDOM_STATE) {
+            // У случайного состояния нет ходов - печатается строка состояния
+            RGBColor cubeColors[6][9];
+            CubeState state;
+            scramble_cube(cubeColors, seed, r, scramble_len, NULL);
+            cube_state_from_colors((const RGBColor (*)[9])cubeColors, &state);
+            printf("%.54s\n", state.facelets);
+            continue;
+        }
+        if (scramble_len <= 0) {
+            printf("{NULL};\n");
+            continue;
+        }
+        RGBColor cubeColors[6][9];
+        scramble_cube(cubeColors, seed, r, scramble_len, moves);
+        printf("{");
+        for (int i = 0; i < scramble_len; ++i) {
+            if (i > 0) printf(", ");
+            printf("\"%s\"", move_to_string(moves[i]));
+        }
+        printf(", NULL};\n");
+    }
+    free(moves);
+}
+
+// Все прогоны job на options.threads потоках; возвращает, сколько потоков реально работало
+static int run_bench_job(BenchJob* job) {
+    return solver_run_threads(job->options.threads, bench_worker, job);
+}
+
+int run_benchmark(int runs, int scramble_len, const char* csv_path, unsigned int seed, bool quiet,
+                  const SolverOptions* options, bool perf_counters) {
+    if (runs <= 0 || (scramble_len < 0 && scramble_len != BENCHMARK_RANDOM_STATE)) return 1;
     if (!csv_path || csv_path[0] == '\0') csv_path = "benchmark_results.csv";
 
-    if (seed != 0u) {
-        srand(seed);
+    BenchJob job;
+    job.runs = runs;
+    job.scramble_len = scramble_len;
+    job.seed = seed;
+    if (options) {
+        job.options = *options;
+    } else {
+        solver_options_init(&job.options);
+    }
+    job.perf_counters = perf_counters;
+    atomic_init(&job.next, 0);
+
+    // Время сборки и за ним время каждого этапа, по runs значений подряд
+    job.records = malloc(sizeof(BenchRecord) * runs);
+    long long* solve_ns = malloc(sizeof(long long) * runs * (1 + SOLVER_STAGE_COUNT));
+    if (!job.records || !solve_ns) {
+        free(job.records);
+        free(solve_ns);
+        return 1;
     }
+    long long* stage_ns = solve_ns + runs;
+    long stage_moves[SOLVER_STAGE_COUNT] = {0};
 
     FILE* fp = fopen(csv_path, "w");
     if (!fp) {
         fprintf(stderr, "Failed to open output file: %s\n", csv_path);
+        free(job.records);
+        free(solve_ns);
         return 2;
     }
-    fprintf(fp, "run,moves,solved\n");
 
-    cube_solver_set_quiet(quiet);
+    job.cache = job.options.cache_bytes > 0 ? solver_cache_create(job.options.cache_bytes) : NULL;
+    job.options.cache_bytes = 0;
+
+    // Таблицы строятся до первого замера, иначе первая сборка (и её соседи по потокам) ждала бы их
+    solver_warm_up(&job.options);
+
+    size_t heap_start = solver_heap_calls();
+    int threads = run_bench_job(&job);
+    size_t heap_total = solver_heap_calls() - heap_start;
+
+    if (!quiet) print_scrambles(runs, scramble_len, seed);
+
+    // seed и scramble - чтобы сравнение видело, те же ли скрамблы у прогонов с одним номером
+    fprintf(fp, "run,moves,solved,cost,solve_ns,seed,scramble");
+    for (int stage = 0; stage < SOLVER_STAGE_COUNT; ++stage) {
+        const char* name = solver_stage_name((SolverStageId)stage);
+        fprintf(fp, ",%s_ns,%s_moves", name, name);
+    }
+    for (int i = 0; perf_counters && i < PERF_COUNTER_COUNT; ++i) {
+        fprintf(fp, ",%s", perf_counter_name((PerfCounterId)i));
+    }
+    fprintf(fp, "\n");
+
+    size_t total_moves = 0;
+    long total_cost = 0;
+    long long solve_total = 0;
+    // Обращения решателя к куче: первая сборка заводит арену, дальше должно быть 0
+    size_t steady_heap_calls = 0;
+    size_t max_heap_calls = 0;
+
     for (int r = 0; r < runs; ++r) {
-        Scene scene;
-        memset(&scene, 0, sizeof(Scene));
-        set_solved_cube(&scene);
+        const BenchRecord* record = &job.records[r];
+        total_moves += record->moves;
+        total_cost += record->cost;
+        solve_ns[r] = record->solve_ns;
+        solve_total += record->solve_ns;
+        if (r > 0) {
+            steady_heap_calls += record->heap_calls;
+            if (record->heap_calls > max_heap_calls) max_heap_calls = record->heap_calls;
+        }
 
-        char lastFace = '\0';
-        if (scramble_len <= 0) {
-            if (!quiet) printf("{NULL};\n");
-        } else {
-            if (!quiet) printf("{");
-            for (int i = 0; i < scramble_len; ++i) {
-                char chosenFace = '\0';
-                Move m = pick_move_like_gui(lastFace, &chosenFace);
-                apply_move_to_cube_colors(scene.cubeColors, m);
-                const char* ms = move_to_string(m);
-                if (!quiet) {
-                if (i > 0) printf(", ");
-                printf("\"%s\"", ms);
-                }
-                lastFace = chosenFace;
-            }
-            if (!quiet) printf(", NULL};\n");
+        fprintf(fp, "%d,%zu,%d,%d,%lld,%u,%d", r + 1, record->moves, record->solved ? 1 : 0, record->cost,
+                record->solve_ns, seed, scramble_len);
+        for (int stage = 0; stage < SOLVER_STAGE_COUNT; ++stage) {
+            stage_ns[(size_t)stage * runs + r] = record->stages.ns[stage];
+            stage_moves[stage] += record->stages.moves[stage];
+            fprintf(fp, ",%lld,%d", record->stages.ns[stage], record->stages.moves[stage]);
+        }
+        for (int i = 0; perf_counters && i < PERF_COUNTER_COUNT; ++i) {
+            fprintf(fp, ",%lld", record->perf.values[i]);
         }
+        fprintf(fp, "\n");
+    }
 
-        bool solved = false;
-        char** sequence = cube_solver_solve(&scene, &solved);
-        size_t moves = count_move_sequence(sequence);
+    fclose(fp);
+
+    printf("Average solution: %.3f moves, %.3f cost (%s)\n", (double)total_moves / runs, (double)total_cost / runs,
+           solver_metric_name(job.options.metric));
+    print_latency_summary(solve_ns, runs);
+    print_stage_summary(stage_ns, stage_moves, &solve_total, runs);
+    if (perf_counters) print_perf_summary(job.records, runs);
+
+    if (job.cache) {
+        SolverCacheStats cache = solver_cache_stats(job.cache);
+        printf("Solver cache: %lu hits, %lu misses, %lu evictions (%zu entries)\n",
+               cache.hits, cache.misses, cache.evictions, cache.entries);
+    }
+    solver_cache_destroy(job.cache);
+
+    // Строки результата принадлежат вызывающему и в счётчик не входят
+    if (threads == 1) {
+        printf("Solver heap calls: first solve %zu, later solves %zu total (max %zu per solve, %.3f avg)\n",
+               job.records[0].heap_calls, steady_heap_calls, max_heap_calls,
+               runs > 1 ? (double)steady_heap_calls / (runs - 1) : 0.0);
+    } else {
+        // Счётчик общий для всех потоков, по сборкам его не разделить
+        printf("Solver heap calls: %zu total over %d threads\n", heap_total, threads);
+    }
+
+    free(job.records);
+    free(solve_ns);
+    return 0;
+}
 
-        fprintf(fp, "%d,%zu,%d\n", r + 1, moves, solved ? 1 : 0);
+typedef struct {
+    long long deadline_ns;
+    int scramble_len;
+    unsigned int seed;
+    SolverOptions options;
+    SolverCache* cache;
+    atomic_int next;  // Номер следующего скрамбла
+    atomic_llong solves;
+    atomic_llong solution_moves;
+    atomic_llong applied_moves; // Ходы, применённые решателем к наклейкам (без скрамблов)
+} ThroughputJob;
 
+// Решает скрамблы, пока не выйдет время; итоги потока складываются в job один раз в конце
+static void* throughput_worker(void* arg) {
+    ThroughputJob* job = arg;
+
+    SolverContext ctx;
+    solver_context_init(&ctx, &job->options);
+    ctx.log = NULL;
+    ctx.cache = job->cache;
+
+    long long solves = 0;
+    long long solution_moves = 0;
+    long long applied_moves = 0;
+    while (now_ns() < job->deadline_ns) {
+        int r = atomic_fetch_add(&job->next, 1);
+        RGBColor cubeColors[6][9];
+        scramble_cube(cubeColors, job->seed, r, job->scramble_len, NULL);
+
+        bool solved = false;
+        unsigned long long applied_before = solver_applied_moves();
+        char** sequence = cube_solver_solve_ctx(&ctx, (const RGBColor (*)[9])cubeColors, &solved);
+        applied_moves += (long long)(solver_applied_moves() - applied_before);
+        solution_moves += (long long)count_move_sequence(sequence);
+        solves++;
         free_move_sequence(sequence);
     }
 
+    atomic_fetch_add(&job->solves, solves);
+    atomic_fetch_add(&job->solution_moves, solution_moves);
+    atomic_fetch_add(&job->applied_moves, applied_moves);
+    solver_context_destroy(&ctx);
+    return NULL;
+}
+
+typedef struct {
+    int threads;
+    double seconds;
+    long long solves;
+    long long solution_moves;
+    long long applied_moves;
+} ThroughputResult;
+
+static ThroughputResult throughput_pass(double seconds, int threads, int scramble_len, unsigned int seed,
+                                        const SolverOptions* options) {
+    ThroughputJob job;
+    job.scramble_len = scramble_len;
+    job.seed = seed;
+    job.options = *options;
+    job.cache = job.options.cache_bytes > 0 ? solver_cache_create(job.options.cache_bytes) : NULL;
+    job.options.cache_bytes = 0;
+    atomic_init(&job.next, 0);
+    atomic_init(&job.solves, 0);
+    atomic_init(&job.solution_moves, 0);
+    atomic_init(&job.applied_moves, 0);
+
+    // Таблицы строятся вне замера, до старта часов
+    solver_warm_up(options);
+
+    long long start = now_ns();
+    job.deadline_ns = start + (long long)(seconds * 1e9);
+
+    int started = solver_run_threads(threads, throughput_worker, &job);
+
+    ThroughputResult result;
+    result.threads = started;
+    result.seconds = (now_ns() - start) / 1e9;
+    result.solves = atomic_load(&job.solves);
+    result.solution_moves = atomic_load(&job.solution_moves);
+    result.applied_moves = atomic_load(&job.applied_moves);
+    solver_cache_destroy(job.cache);
+    return result;
+}
+
+static void print_throughput(const char* label, const ThroughputResult* result) {
+    printf("%s: %d thread(s), %lld solves in %.3f s: %.1f solves/s, %.0f solution moves/s, %.0f applied moves/s\n",
+           label, result->threads, result->solves, result->seconds,
+           result->solves / result->seconds,
+           result->solution_moves / result->seconds,
+           result->applied_moves / result->seconds);
+}
+
+int run_throughput_benchmark(double seconds, int scramble_len, unsigned int seed, const SolverOptions* options) {
+    if (seconds <= 0.0 || (scramble_len < 0 && scramble_len != BENCHMARK_RANDOM_STATE)) return 1;
+
+    SolverOptions opts;
+    if (options) {
+        opts = *options;
+    } else {
+        solver_options_init(&opts);
+    }
+    int threads = opts.threads > 1 ? opts.threads : 1;
+    if (threads > SOLVER_MAX_THREADS) threads = SOLVER_MAX_THREADS;
+
+    // Для эффективности масштабирования нужен замер на одном потоке той же длительности
+    ThroughputResult single = throughput_pass(seconds, 1, scramble_len, seed, &opts);
+    print_throughput("Throughput", &single);
+    if (threads == 1) return 0;
+
+    ThroughputResult multi = throughput_pass(seconds, threads, scramble_len, seed, &opts);
+    print_throughput("Throughput", &multi);
+
+    double single_rate = single.solves / single.seconds;
+    double multi_rate = multi.solves / multi.seconds;
+    printf("Scaling: %.2fx on %d threads, efficiency %.1f%%\n",
+           single_rate > 0 ? multi_rate / single_rate : 0.0, multi.threads,
+           single_rate > 0 ? 100.0 * multi_rate / (single_rate * multi.threads) : 0.0);
+    return 0;
+}
+
+int run_scramble_sweep(int runs, int from, int to, int step, const char* csv_path, unsigned int seed,
+                       const SolverOptions* options) {
+    if (runs <= 0 || from < 0 || to < from || step <= 0) return 1;
+    if (!csv_path || csv_path[0] == '\0') csv_path = "benchmark_sweep.csv";
+
+    BenchJob job;
+    job.runs = runs;
+    job.seed = seed;
+    if (options) {
+        job.options = *options;
+    } else {
+        solver_options_init(&job.options);
+    }
+    job.perf_counters = false;
+    size_t cache_bytes = job.options.cache_bytes;
+    job.options.cache_bytes = 0;
+
+    job.records = malloc(sizeof(BenchRecord) * runs);
+    long long* solve_ns = malloc(sizeof(long long) * runs);
+    if (!job.records || !solve_ns) {
+        free(job.records);
+        free(solve_ns);
+        return 1;
+    }
+
+    FILE* fp = fopen(csv_path, "w");
+    if (!fp) {
+        fprintf(stderr, "Failed to open output file: %s\n", csv_path);
+        free(job.records);
+        free(solve_ns);
+        return 2;
+    }
+    fprintf(fp, "scramble,runs,solve_rate,mean_moves,mean_cost,mean_ns,p50_ns,p90_ns,p99_ns,max_ns\n");
+
+    printf("%8s %10s %10s %10s %10s %10s %10s %10s %10s\n", "scramble", "solved %", "moves", "cost",
+           "mean us", "p50 us", "p90 us", "p99 us", "max us");
+
+    solver_warm_up(&job.options);
+
+    for (int length = from; length <= to; length += step) {
+        // Свой кэш на каждую длину: попадания из других длин исказили бы время
+        job.scramble_len = length;
+        job.cache = cache_bytes > 0 ? solver_cache_create(cache_bytes) : NULL;
+        atomic_init(&job.next, 0);
+        run_bench_job(&job);
+        solver_cache_destroy(job.cache);
+
+        long solved = 0;
+        long long total_moves = 0, total_cost = 0, total_ns = 0;
+        for (int r = 0; r < runs; ++r) {
+            solved += job.records[r].solved;
+            total_moves += (long long)job.records[r].moves;
+            total_cost += job.records[r].cost;
+            total_ns += job.records[r].solve_ns;
+            solve_ns[r] = job.records[r].solve_ns;
+        }
+        qsort(solve_ns, runs, sizeof(long long), compare_ns);
+
+        double rate = 100.0 * solved / runs;
+        double mean_ns = (double)total_ns / runs;
+        long long p50 = percentile_ns(solve_ns, runs, 50.0);
+        long long p90 = percentile_ns(solve_ns, runs, 90.0);
+        long long p99 = percentile_ns(solve_ns, runs, 99.0);
+        long long max = solve_ns[runs - 1];
+
+        printf("%8d %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f %10.3f\n", length, rate,
+               (double)total_moves / runs, (double)total_cost / runs, mean_ns / 1000.0,
+               p50 / 1000.0, p90 / 1000.0, p99 / 1000.0, max / 1000.0);
+        fprintf(fp, "%d,%d,%.6f,%.6f,%.6f,%.0f,%lld,%lld,%lld,%lld\n", length, runs, rate / 100.0,
+                (double)total_moves / runs, (double)total_cost / runs, mean_ns, p50, p90, p99, max);
+    }
+
     fclose(fp);
+    free(job.records);
+    free(solve_ns);
     return 0;
 }
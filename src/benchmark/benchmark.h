@@ -3,7 +3,48 @@
 
 #include <stddef.h>
 #include <stdbool.h>
+#include "../solver/cube_solver.h"
 
-int run_benchmark(int runs, int scramble_len, const char* csv_path, unsigned int seed, bool quiet);
+// scramble_len: вместо ходов - равномерно случайное собираемое состояние
+#define BENCHMARK_RANDOM_STATE (-1)
+
+/*
+    Прогон r решает скрамбл из своего потока случайных чисел (seed, r), прогоны
+    раздаются options->threads потокам, а CSV и итоги пишутся по порядку
+    прогонов. Поэтому всё, кроме времени, не зависит от числа потоков (кэш
+    решений, общий для потоков, может это нарушить - попадания зависят от
+    порядка). quiet = false печатает скрамблы, лог решателя не выводится.
+    perf_counters добавляет аппаратные счётчики каждой сборки (perf_counters.h).
+*/
+// options may be NULL for solver defaults
+int run_benchmark(int runs, int scramble_len, const char* csv_path, unsigned int seed, bool quiet,
+                  const SolverOptions* options, bool perf_counters);
+
+/*
+    Прогон по длинам скрамбла from, from + step, ..., to: на каждой длине runs
+    сборок (те же потоки случайных чисел, что у run_benchmark). В csv_path и
+    на экран - по строке на длину: доля собранных, средние ходы и цена,
+    перцентили времени.
+*/
+int run_scramble_sweep(int runs, int from, int to, int step, const char* csv_path, unsigned int seed,
+                       const SolverOptions* options);
+
+/*
+    Пропускная способность: за seconds секунд решается сколько успеет
+    options->threads потоков. Сначала такой же замер на одном потоке - от него
+    считается эффективность масштабирования. Applied moves - вызовы
+    apply_move_to_cube_colors внутри решателя.
+*/
+int run_throughput_benchmark(double seconds, int scramble_len, unsigned int seed, const SolverOptions* options);
+
+/*
+    Сравнение CSV бенчмарка с базовым: средние ходы и попрогонно по совпавшим
+    прогонам (тот же номер, seed и длина скрамбла), доля собранных, сдвиг
+    времени (U-критерий Манна-Уитни). Регрессия - на совпавших прогонах ходов
+    больше чем на threshold_pct процентов (без совпавших ходы не проверяются),
+    собранных меньше, или значимо (p < 0.01) медленнее с медианой хуже threshold_pct.
+    Возвращает 0, 3 при регрессии, 2 если файл не прочитан.
+*/
+int compare_benchmark(const char* baseline_csv, const char* current_csv, double threshold_pct);
 
 #endif /* BENCHMARK_H */
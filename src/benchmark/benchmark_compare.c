@@ -0,0 +1,308 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdbool.h>
+
+#include "benchmark.h"
+
+// Уровень значимости сдвига времени по Манну-Уитни
+#define COMPARE_ALPHA 0.01
+#define COMPARE_LINE_MAX 1024
+
+typedef struct {
+    int count;
+    int capacity;
+    int* run;
+    int* moves;
+    bool* solved;
+    long long* solve_ns; // NULL - в файле нет времени (старые CSV: run,moves,solved)
+    long long* seed;     // NULL - в файле нет seed и длины скрамбла (CSV до их появления)
+    int* scramble;
+} BenchTable;
+
+static void bench_table_free(BenchTable* table) {
+    free(table->run);
+    free(table->moves);
+    free(table->solved);
+    free(table->solve_ns);
+    free(table->seed);
+    free(table->scramble);
+    memset(table, 0, sizeof(*table));
+}
+
+static bool bench_table_grow(BenchTable* table, bool with_time, bool with_scramble) {
+    int capacity = table->capacity ? table->capacity * 2 : 1024;
+    int* run = realloc(table->run, sizeof(int) * capacity);
+    if (run) table->run = run;
+    int* moves = realloc(table->moves, sizeof(int) * capacity);
+    if (moves) table->moves = moves;
+    bool* solved = realloc(table->solved, sizeof(bool) * capacity);
+    if (solved) table->solved = solved;
+    if (!run || !moves || !solved) return false;
+    if (with_time) {
+        long long* solve_ns = realloc(table->solve_ns, sizeof(long long) * capacity);
+        if (!solve_ns) return false;
+        table->solve_ns = solve_ns;
+    }
+    if (with_scramble) {
+        long long* seed = realloc(table->seed, sizeof(long long) * capacity);
+        if (seed) table->seed = seed;
+        int* scramble = realloc(table->scramble, sizeof(int) * capacity);
+        if (scramble) table->scramble = scramble;
+        if (!seed || !scramble) return false;
+    }
+    table->capacity = capacity;
+    return true;
+}
+
+// Номер столбца с таким именем в строке заголовка или -1
+static int header_column(const char* header, const char* name) {
+    size_t length = strlen(name);
+    int column = 0;
+    for (const char* p = header; *p; column++) {
+        size_t field = strcspn(p, ",\r\n");
+        if (field == length && strncmp(p, name, length) == 0) return column;
+        p += field;
+        if (*p != ',') break;
+        p++;
+    }
+    return -1;
+}
+
+// Столбцы ищутся по заголовку, так что читаются и старые, и новые CSV бенчмарка
+static bool bench_table_read(const char* path, BenchTable* table) {
+    memset(table, 0, sizeof(*table));
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        fprintf(stderr, "Failed to open %s\n", path);
+        return false;
+    }
+
+    char line[COMPARE_LINE_MAX];
+    if (!fgets(line, sizeof(line), fp)) {
+        fclose(fp);
+        fprintf(stderr, "%s is empty\n", path);
+        return false;
+    }
+    int run_col = header_column(line, "run");
+    int moves_col = header_column(line, "moves");
+    int solved_col = header_column(line, "solved");
+    int ns_col = header_column(line, "solve_ns");
+    int seed_col = header_column(line, "seed");
+    int scramble_col = header_column(line, "scramble");
+    if (seed_col < 0 || scramble_col < 0) seed_col = scramble_col = -1;
+    if (run_col < 0 || moves_col < 0 || solved_col < 0) {
+        fclose(fp);
+        fprintf(stderr, "%s: expected run, moves and solved columns\n", path);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), fp)) {
+        if (line[0] == '\n' || line[0] == '\r' || line[0] == '\0') continue;
+        if (table->count == table->capacity && !bench_table_grow(table, ns_col >= 0, seed_col >= 0)) {
+            fclose(fp);
+            bench_table_free(table);
+            return false;
+        }
+
+        int i = table->count;
+        const char* p = line;
+        for (int column = 0; *p; column++) {
+            long long value = strtoll(p, NULL, 10);
+            if (column == run_col) table->run[i] = (int)value;
+            if (column == moves_col) table->moves[i] = (int)value;
+            if (column == solved_col) table->solved[i] = value != 0;
+            if (column == ns_col) table->solve_ns[i] = value;
+            if (column == seed_col) table->seed[i] = value;
+            if (column == scramble_col) table->scramble[i] = (int)value;
+            p = strchr(p, ',');
+            if (!p) break;
+            p++;
+        }
+        table->count++;
+    }
+    fclose(fp);
+
+    if (table->count == 0) {
+        fprintf(stderr, "%s has no runs\n", path);
+        bench_table_free(table);
+        return false;
+    }
+    return true;
+}
+
+typedef struct {
+    long long value;
+    int group; // 0 - базовый файл, 1 - текущий
+} RankedSample;
+
+static int compare_samples(const void* a, const void* b) {
+    long long x = ((const RankedSample*)a)->value;
+    long long y = ((const RankedSample*)b)->value;
+    return (x > y) - (x < y);
+}
+
+/*
+    U-критерий Манна-Уитни для двух независимых выборок времени: ранги по
+    объединённой выборке (одинаковым значениям - средний ранг), z с поправкой
+    на связки и непрерывность. Возвращает двусторонний p; u - U второй выборки,
+    z > 0 - вторая выборка в среднем больше.
+*/
+static double mann_whitney(const long long* a, int n1, const long long* b, int n2, double* u, double* z) {
+    *u = 0.0;
+    *z = 0.0;
+    int n = n1 + n2;
+    if (n1 < 1 || n2 < 1 || n < 2) return 1.0;
+    RankedSample* samples = malloc(sizeof(RankedSample) * n);
+    if (!samples) return 1.0;
+    for (int i = 0; i < n1; i++) samples[i] = (RankedSample){a[i], 0};
+    for (int i = 0; i < n2; i++) samples[n1 + i] = (RankedSample){b[i], 1};
+    qsort(samples, n, sizeof(RankedSample), compare_samples);
+
+    double rank_sum = 0.0;
+    double tie_sum = 0.0;
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j < n && samples[j].value == samples[i].value) j++;
+        double rank = (i + 1 + j) / 2.0;
+        for (int k = i; k < j; k++) {
+            if (samples[k].group == 1) rank_sum += rank;
+        }
+        double t = j - i;
+        tie_sum += t * t * t - t;
+        i = j;
+    }
+    free(samples);
+
+    *u = rank_sum - (double)n2 * (n2 + 1) / 2.0;
+    double mean = (double)n1 * n2 / 2.0;
+    double variance = (double)n1 * n2 / 12.0 * ((n + 1) - tie_sum / ((double)n * (n - 1)));
+    if (variance <= 0.0) {
+        *z = 0.0;
+        return 1.0;
+    }
+    double diff = *u - mean;
+    double corrected = fabs(diff) > 0.5 ? fabs(diff) - 0.5 : 0.0;
+    *z = (diff < 0 ? -corrected : corrected) / sqrt(variance);
+    return erfc(fabs(*z) / sqrt(2.0));
+}
+
+static int compare_ll(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Перцентиль по ближайшему рангу; values сортируется на месте
+static double percentile_us(long long* values, int count, double p) {
+    qsort(values, count, sizeof(long long), compare_ll);
+    int rank = (int)(p / 100.0 * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return values[rank - 1] / 1000.0;
+}
+
+static double percent_change(double before, double after) {
+    return before != 0.0 ? 100.0 * (after - before) / before : 0.0;
+}
+
+int compare_benchmark(const char* baseline_csv, const char* current_csv, double threshold_pct) {
+    BenchTable base, cur;
+    if (!bench_table_read(baseline_csv, &base)) return 2;
+    if (!bench_table_read(current_csv, &cur)) {
+        bench_table_free(&base);
+        return 2;
+    }
+
+    printf("Comparing %s (%d runs) with baseline %s (%d runs), threshold %.2f%%\n",
+           current_csv, cur.count, baseline_csv, base.count, threshold_pct);
+    bool regression = false;
+
+    // Ходы: средние по всем прогонам для справки, порог - только по совпавшим прогонам
+    double base_moves = 0.0, cur_moves = 0.0;
+    int base_solved = 0, cur_solved = 0;
+    for (int i = 0; i < base.count; i++) {
+        base_moves += base.moves[i];
+        base_solved += base.solved[i];
+    }
+    for (int i = 0; i < cur.count; i++) {
+        cur_moves += cur.moves[i];
+        cur_solved += cur.solved[i];
+    }
+    base_moves /= base.count;
+    cur_moves /= cur.count;
+    printf("  moves:      %.3f -> %.3f (%+.2f%%) over all runs\n", base_moves, cur_moves,
+           percent_change(base_moves, cur_moves));
+
+    // Прогон совпадает, если у него тот же номер, а где записаны seed и длина скрамбла - и они (тот же скрамбл)
+    bool same_scrambles = base.seed && cur.seed;
+    int matched = 0, better = 0, worse = 0;
+    double matched_base = 0.0, matched_cur = 0.0;
+    for (int i = 0; i < cur.count && i < base.count; i++) {
+        if (cur.run[i] != base.run[i]) continue;
+        if (same_scrambles && (cur.seed[i] != base.seed[i] || cur.scramble[i] != base.scramble[i])) continue;
+        matched++;
+        matched_base += base.moves[i];
+        matched_cur += cur.moves[i];
+        if (cur.moves[i] < base.moves[i]) better++;
+        if (cur.moves[i] > base.moves[i]) worse++;
+    }
+
+    if (matched == 0) {
+        // Разные скрамблы: разница средних была бы просто разбросом скрамблов
+        printf("  WARNING: no run matches the baseline (different seed, scramble length or run numbers), "
+               "moves are not gated\n");
+    } else {
+        matched_base /= matched;
+        matched_cur /= matched;
+        double moves_change = percent_change(matched_base, matched_cur);
+        printf("  matched:    %d runs, %.3f -> %.3f (%+.2f%%); %d shorter, %d longer, %d same\n",
+               matched, matched_base, matched_cur, moves_change, better, worse, matched - better - worse);
+        if (!same_scrambles) {
+            printf("  note: seed is not recorded in one of the files, runs are matched by number only\n");
+        }
+        if (moves_change > threshold_pct) {
+            printf("  REGRESSION: moves on the matched runs grew by more than %.2f%%\n", threshold_pct);
+            regression = true;
+        }
+    }
+
+    double base_rate = 100.0 * base_solved / base.count;
+    double cur_rate = 100.0 * cur_solved / cur.count;
+    printf("  solve rate: %.3f%% -> %.3f%% (%+.3f pp)\n", base_rate, cur_rate, cur_rate - base_rate);
+    if (cur_rate < base_rate) {
+        printf("  REGRESSION: solve rate dropped\n");
+        regression = true;
+    }
+
+    // С одним прогоном в файле дисперсия U не определена
+    if (base.solve_ns && cur.solve_ns && (base.count < 2 || cur.count < 2)) {
+        printf("  latency:    not compared, need at least 2 runs in each file\n");
+    } else if (base.solve_ns && cur.solve_ns) {
+        double u, z;
+        double p = mann_whitney(base.solve_ns, base.count, cur.solve_ns, cur.count, &u, &z);
+
+        double base_p50 = percentile_us(base.solve_ns, base.count, 50.0);
+        double cur_p50 = percentile_us(cur.solve_ns, cur.count, 50.0);
+        printf("  latency:    p50 %.3f -> %.3f us (%+.2f%%), p90 %.3f -> %.3f us, p99 %.3f -> %.3f us\n",
+               base_p50, cur_p50, percent_change(base_p50, cur_p50),
+               percentile_us(base.solve_ns, base.count, 90.0), percentile_us(cur.solve_ns, cur.count, 90.0),
+               percentile_us(base.solve_ns, base.count, 99.0), percentile_us(cur.solve_ns, cur.count, 99.0));
+        // U / (n1 n2) - вероятность, что случайная текущая сборка дольше случайной базовой
+        printf("  Mann-Whitney: U = %.0f, P(current slower) = %.3f, z = %+.3f, p = %.3g\n",
+               u, u / ((double)base.count * cur.count), z, p);
+        if (p < COMPARE_ALPHA && z > 0 && percent_change(base_p50, cur_p50) > threshold_pct) {
+            printf("  REGRESSION: solves are significantly slower (p < %.2f, median +%.2f%%)\n",
+                   COMPARE_ALPHA, percent_change(base_p50, cur_p50));
+            regression = true;
+        }
+    } else {
+        printf("  latency:    not compared, solve_ns is missing in one of the files\n");
+    }
+
+    printf("Result: %s\n", regression ? "REGRESSION" : "OK");
+    bench_table_free(&base);
+    bench_table_free(&cur);
+    return regression ? 3 : 0;
+}
@@ -0,0 +1,117 @@
+#include "perf_counters.h"
+#include <string.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static const unsigned long long counter_config[PERF_COUNTER_COUNT] = {
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+// Счётчик только этого потока (pid 0) на любом процессоре (cpu -1); group -1 - сам лидер группы
+static int open_counter(unsigned long long config, int group) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // Время включения и работы - чтобы пересчитать значение, если ядро делило счётчики по времени
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+int perf_counters_open(PerfCounters* counters) {
+    int opened = 0;
+    int leader = -1;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        // Группа считается целиком в одни и те же промежутки, так что IPC берётся из одного окна
+        counters->fds[i] = open_counter(counter_config[i], leader);
+        if (counters->fds[i] < 0 && leader >= 0) {
+            // В группу не влез (мало аппаратных счётчиков) - считается отдельно, с пересчётом по времени
+            counters->fds[i] = open_counter(counter_config[i], -1);
+        } else if (counters->fds[i] >= 0 && leader < 0) {
+            leader = counters->fds[i];
+        }
+        if (counters->fds[i] >= 0) opened++;
+    }
+    return opened;
+}
+
+void perf_counters_close(PerfCounters* counters) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) close(counters->fds[i]);
+        counters->fds[i] = -1;
+    }
+}
+
+void perf_counters_read(const PerfCounters* counters, PerfSample* sample) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        // value, time_enabled, time_running
+        unsigned long long data[3];
+        if (counters->fds[i] >= 0 && read(counters->fds[i], data, sizeof(data)) == (ssize_t)sizeof(data)) {
+            sample->values[i] = (long long)data[0];
+            sample->enabled_ns[i] = (long long)data[1];
+            sample->running_ns[i] = (long long)data[2];
+        } else {
+            sample->values[i] = -1;
+            sample->enabled_ns[i] = sample->running_ns[i] = 0;
+        }
+    }
+}
+
+#else
+
+int perf_counters_open(PerfCounters* counters) {
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters->fds[i] = -1;
+    }
+    return 0;
+}
+
+void perf_counters_close(PerfCounters* counters) {
+    (void)counters;
+}
+
+void perf_counters_read(const PerfCounters* counters, PerfSample* sample) {
+    (void)counters;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        sample->values[i] = -1;
+        sample->enabled_ns[i] = sample->running_ns[i] = 0;
+    }
+}
+
+#endif
+
+PerfSample perf_sample_diff(const PerfSample* before, const PerfSample* after) {
+    PerfSample diff;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        diff.enabled_ns[i] = after->enabled_ns[i] - before->enabled_ns[i];
+        diff.running_ns[i] = after->running_ns[i] - before->running_ns[i];
+        if (before->values[i] < 0 || after->values[i] < 0 || diff.running_ns[i] <= 0) {
+            // Недоступен или за это время ни разу не был на процессоре
+            diff.values[i] = -1;
+            continue;
+        }
+
+        // Ядро делило счётчики по времени: значение экстраполируется на всё время участка
+        long long value = after->values[i] - before->values[i];
+        if (diff.running_ns[i] < diff.enabled_ns[i]) {
+            value = (long long)((double)value * diff.enabled_ns[i] / diff.running_ns[i]);
+        }
+        diff.values[i] = value;
+    }
+    return diff;
+}
+
+const char* perf_counter_name(PerfCounterId id) {
+    static const char* const names[PERF_COUNTER_COUNT] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+    if ((unsigned)id >= PERF_COUNTER_COUNT) return "?";
+    return names[id];
+}
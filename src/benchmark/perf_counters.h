@@ -0,0 +1,43 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <stdbool.h>
+
+typedef enum {
+    PERF_COUNTER_CYCLES,
+    PERF_COUNTER_INSTRUCTIONS,
+    PERF_COUNTER_CACHE_MISSES,
+    PERF_COUNTER_BRANCH_MISSES,
+    PERF_COUNTER_COUNT
+} PerfCounterId;
+
+/*
+    Аппаратные счётчики вызывающего потока (Linux perf_event_open, только
+    пользовательский режим). Счётчики открываются одной группой и считают в
+    одни и те же промежутки времени; если процессор или ядро какой-то не даёт
+    (виртуалка, perf_event_paranoid), остальные работают. Когда ядро делит
+    счётчики по времени, perf_sample_diff пересчитывает разницу на всё время
+    участка.
+    На других системах не открывается ни один.
+*/
+typedef struct {
+    int fds[PERF_COUNTER_COUNT]; // -1 - счётчик недоступен
+} PerfCounters;
+
+typedef struct {
+    long long values[PERF_COUNTER_COUNT];     // -1 - счётчик недоступен
+    long long enabled_ns[PERF_COUNTER_COUNT]; // Сколько счётчик был включён
+    long long running_ns[PERF_COUNTER_COUNT]; // Сколько из этого реально считал
+} PerfSample;
+
+// Returns the number of counters opened; the rest read as -1
+int perf_counters_open(PerfCounters* counters);
+void perf_counters_close(PerfCounters* counters);
+// Raw running totals since open; subtract two reads with perf_sample_diff to measure a region
+void perf_counters_read(const PerfCounters* counters, PerfSample* sample);
+// after - before per counter, scaled by enabled / running time if the counters were multiplexed;
+// -1 where either side is unavailable or the counter never ran in between
+PerfSample perf_sample_diff(const PerfSample* before, const PerfSample* after);
+const char* perf_counter_name(PerfCounterId id);
+
+#endif /* PERF_COUNTERS_H */
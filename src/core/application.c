@@ -35,6 +35,11 @@ bool application_init(Application* app) {
         fprintf(stderr, "Failed to initialize Rubik's cube scene\n");
         return false;
     }
+
+    SolverOptions solverOptions;
+    solver_options_init(&solverOptions);
+    solverOptions.cache_bytes = APPLICATION_SOLVER_CACHE_BYTES;
+    solver_context_init(&app->solver, &solverOptions);
     
     app->running = true;
     app->lastFrame = 0.0f;
@@ -94,6 +99,7 @@ void application_run(Application* app) {
 // Очистка ресурсов
 void application_cleanup(Application* app) {
     scene_destroy(&app->scene);
+    solver_context_destroy(&app->solver);
     texture_cleanup_system();
     window_destroy(&app->window);
 } 
\ No newline at end of file
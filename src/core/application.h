@@ -3,11 +3,16 @@
 
 #include "window.h"
 #include "../scene/scene.h"
+#include "../solver/cube_solver.h"
 #include <stdbool.h>
 
+// Кэш решений GUI: повторное нажатие S на том же состоянии не запускает решатель
+#define APPLICATION_SOLVER_CACHE_BYTES (1024 * 1024)
+
 typedef struct Application {
     Window window;
     Scene scene;
+    SolverContext solver;
     bool running;
     float lastFrame;
     float deltaTime;
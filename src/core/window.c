@@ -4,6 +4,8 @@
 #include "application.h"
 #include "../scene/scene.h"
 #include "../solver/cube_solver.h"
+#include "../solver/cube_validate.h"
+#include "../math/rng.h"
 #include <stdio.h>
 #include <math.h>
 #include <stdlib.h>
@@ -11,7 +13,7 @@
 
 static void handle_move_sequence(struct Application* app, char** moveSequence, bool browseMode, float speed);
 static char** generate_random_move_sequence(int length);
-static char* generate_random_move(char excludeFace);
+static char* generate_random_move(Rng* rng, char excludeFace);
 static void framebuffer_size_callback(GLFWwindow* handle, int width, int height);
 
 // Функция для изменения размеров окна
@@ -22,19 +24,28 @@ static void framebuffer_size_callback(GLFWwindow* handle, int width, int height)
     window->height = height;
 }
 
+// Генератор скрамблов окна; засевается временем при первом скрамбле
+static Rng g_scramble_rng;
+static bool g_scramble_rng_seeded = false;
+
 static char** generate_random_move_sequence(int length) {
+    if (!g_scramble_rng_seeded) {
+        rng_seed(&g_scramble_rng, (unsigned long long)time(NULL));
+        g_scramble_rng_seeded = true;
+    }
+
     char** moveSequence = malloc((length + 1) * sizeof(char*));
     char lastFace = '\0';
     
     for (int i = 0; i < length; i++) {
-        moveSequence[i] = generate_random_move(lastFace);
+        moveSequence[i] = generate_random_move(&g_scramble_rng, lastFace);
         lastFace = moveSequence[i][0];
     }
     moveSequence[length] = NULL;
     return moveSequence;
 }
 
-static char* generate_random_move(char excludeFace) {
+static char* generate_random_move(Rng* rng, char excludeFace) {
     char* move_names[] = {
         "U", "U'", "U2",
         "D", "D'", "D2",
@@ -53,7 +64,7 @@ static char* generate_random_move(char excludeFace) {
         }
     }
     
-    int random_move = rand() % available_count;
+    int random_move = (int)rng_below(rng, (unsigned int)available_count);
     return available_moves[random_move];
 }
 
@@ -130,7 +141,7 @@ static void key_callback(GLFWwindow* handle, int key, int scancode, int action,
             else if (key == GLFW_KEY_6) {
                 scene_set_color_for_current_cell(&app->scene, window, 'Y');
             }
-            // Выйти из режима раскраски можно только если куб валидный (решается)
+            // Выйти из режима раскраски можно только если куб валидный (собирается поворотами граней)
             else if (key == GLFW_KEY_C) {
                 char* cubeString = scene_get_cube_state_as_string(app->scene.cubeColors);
                 
@@ -151,15 +162,15 @@ static void key_callback(GLFWwindow* handle, int key, int scancode, int action,
                     scene_set_cube_state_from_string(&app->scene, solidColors);
                     scene_exit_color_mode(&app->scene, window);
                 } else {
-                    bool isSolved = false;
-                    char** moveSequence = cube_solver_solve(&app->scene, &isSolved);
-                    if (isSolved) {
+                    CubeStateError error = cube_state_validate((const RGBColor (*)[9])app->scene.cubeColors);
+                    if (error == CUBE_STATE_VALID) {
                         scene_exit_color_mode(&app->scene, window);
                     }
                     else {
-                        printf("Not valid cube state\n");
+                        printf("Not valid cube state: %s\n", cube_state_error_string(error));
                     }
                 }
+                free(cubeString);
             }
             return; // Не обрабатывать другие клавиши в режиме цвета
         }
@@ -223,7 +234,7 @@ static void key_callback(GLFWwindow* handle, int key, int scancode, int action,
         // Решение куба
         if (key == GLFW_KEY_S) {
             bool isSolved = false;
-            char** moveSequence = cube_solver_solve(&app->scene, &isSolved);
+            char** moveSequence = scene_solve_cube(&app->scene, &app->solver, &isSolved);
             
             if (isSolved) {
                 handle_move_sequence(app, moveSequence, mods & GLFW_MOD_SHIFT, 3.0f);
@@ -0,0 +1,27 @@
+#ifndef CUBE_STATE_H
+#define CUBE_STATE_H
+
+// Общие типы состояния куба: их используют и решатель, и отрисовка, без зависимостей от GL
+
+typedef struct {
+    float r, g, b;
+} RGBColor;
+
+// Face indices for a Rubik's cube
+typedef enum {
+    FACE_IDX_TOP = 0,    // U - White
+    FACE_IDX_FRONT = 1,  // F - Red
+    FACE_IDX_RIGHT = 2,  // R - Blue 
+    FACE_IDX_BACK = 3,   // B - Orange
+    FACE_IDX_LEFT = 4,   // L - Green
+    FACE_IDX_BOTTOM = 5  // D - Yellow
+} FaceIndex;
+
+// Rotation direction
+typedef enum {
+    ROTATE_CLOCKWISE = 1,
+    ROTATE_COUNTERCLOCKWISE = -1,
+    ROTATE_180 = 2
+} RotationDirection;
+
+#endif /* CUBE_STATE_H */
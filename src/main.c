@@ -1,39 +1,138 @@
 #include "core/application.h"
 #include "benchmark/benchmark.h"
+#include "solver/cube_solver.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 
 static void display_help_message();
+static bool parse_move_costs(SolverOptions* options, const char* spec);
+static double parse_duration(const char* text);
 
 int main(int argc, char** argv) {
-    // CLI benchmark mode: --benchmark N [--scramble S] [--out file.csv] [--seed X] [--quiet]
+    // CLI benchmark mode: --benchmark N [--scramble S|random-state] [--scramble-sweep A:B:STEP] [--out file.csv] [--seed X] [--quiet] [--multislot] [--xcross] [--window] [--no-stitching] [--cache-mb M] [--threads N] [--duration 10s] [--compare baseline.csv] [--threshold PCT] [--perf-counters] [--metric htm|qtm|stm] [--move-cost R2=3,M=2,...]
     if (argc >= 2 && (strcmp(argv[1], "--benchmark") == 0 || strcmp(argv[1], "-b") == 0)) {
-        int runs = (argc >= 3) ? atoi(argv[2]) : 100;
+        // Число прогонов можно опустить: --benchmark --duration 10s
+        bool has_runs = argc >= 3 && argv[2][0] != '-';
+        int runs = has_runs ? atoi(argv[2]) : 100;
+        double duration = 0.0;
+        const char* baseline = NULL;
+        double threshold = 2.0;
+        bool perf_counters = false;
+        int sweep_from = -1, sweep_to = 0, sweep_step = 1;
         int scramble = 25;
         const char* out = "benchmark_results.csv";
         unsigned int seed = 0u;
         int quiet = 0;
+        const char* move_costs = NULL;
+        SolverOptions options;
+        solver_options_init(&options);
 
-        for (int i = 3; i < argc; ++i) {
+        for (int i = has_runs ? 3 : 2; i < argc; ++i) {
             if ((strcmp(argv[i], "--scramble") == 0 || strcmp(argv[i], "-s") == 0) && i + 1 < argc) {
-                scramble = atoi(argv[++i]);
+                ++i;
+                scramble = strcmp(argv[i], "random-state") == 0 ? BENCHMARK_RANDOM_STATE : atoi(argv[i]);
+            } else if (strcmp(argv[i], "--scramble-sweep") == 0 && i + 1 < argc) {
+                // A:B или A:B:STEP
+                int fields = sscanf(argv[++i], "%d:%d:%d", &sweep_from, &sweep_to, &sweep_step);
+                if (fields < 2 || sweep_from < 0 || sweep_to < sweep_from || sweep_step <= 0) {
+                    fprintf(stderr, "Bad scramble sweep: %s (expected A:B[:STEP])\n", argv[i]);
+                    return 1;
+                }
+                if (fields == 2) sweep_step = 1;
             } else if ((strcmp(argv[i], "--out") == 0 || strcmp(argv[i], "-o") == 0) && i + 1 < argc) {
                 out = argv[++i];
             } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
                 seed = (unsigned int)strtoul(argv[++i], NULL, 10);
             } else if ((strcmp(argv[i], "--quiet") == 0) || (strcmp(argv[i], "-q") == 0)) {
                 quiet = 1;
+            } else if (strcmp(argv[i], "--multislot") == 0) {
+                options.multislot = true;
+            } else if (strcmp(argv[i], "--xcross") == 0) {
+                options.xcross = true;
+            } else if (strcmp(argv[i], "--window") == 0) {
+                options.window = true;
+            } else if (strcmp(argv[i], "--no-stitching") == 0) {
+                options.stitching = false;
+            } else if (strcmp(argv[i], "--cache-mb") == 0 && i + 1 < argc) {
+                options.cache_bytes = (size_t)(atof(argv[++i]) * 1024 * 1024);
+            } else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) {
+                duration = parse_duration(argv[++i]);
+                if (duration <= 0.0) {
+                    fprintf(stderr, "Bad duration: %s\n", argv[i]);
+                    return 1;
+                }
+            } else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+                baseline = argv[++i];
+            } else if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+                threshold = atof(argv[++i]);
+            } else if (strcmp(argv[i], "--perf-counters") == 0) {
+                perf_counters = true;
+            } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+                options.threads = atoi(argv[++i]);
+            } else if (strcmp(argv[i], "--metric") == 0 && i + 1 < argc) {
+                SolverMetric metric;
+                if (!solver_metric_from_string(argv[++i], &metric)) {
+                    fprintf(stderr, "Unknown metric: %s\n", argv[i]);
+                    return 1;
+                }
+                solver_options_set_metric(&options, metric);
+            } else if (strcmp(argv[i], "--move-cost") == 0 && i + 1 < argc) {
+                move_costs = argv[++i];
             }
         }
 
-        printf("Running benchmark: runs=%d, scramble=%d, out=%s, seed=%u%s\n", runs, scramble, out, seed, quiet ? ", quiet" : "");
-        int rc = run_benchmark(runs, scramble, out, seed, quiet);
+        // Цены ложатся поверх метрики, поэтому применяются после всех флагов, в каком бы порядке ни шли
+        if (move_costs && !parse_move_costs(&options, move_costs)) {
+            fprintf(stderr, "Bad move costs: %s\n", move_costs);
+            return 1;
+        }
+
+        // Сравнение читает CSV обычного прогона; у развёртки другой формат, у замера пропускной способности файла нет
+        if (baseline && (sweep_from >= 0 || duration > 0.0)) {
+            fprintf(stderr, "--compare works only with a plain run, not with --scramble-sweep or --duration\n");
+            return 1;
+        }
+
+        // Счётчики снимаются вокруг каждой сборки обычного прогона; развёртка и замер пропускной способности их не читают
+        if (perf_counters && (sweep_from >= 0 || duration > 0.0)) {
+            fprintf(stderr, "--perf-counters works only with a plain run, not with --scramble-sweep or --duration\n");
+            return 1;
+        }
+
+        if (sweep_from >= 0) {
+            printf("Running scramble sweep: runs=%d per length, scramble=%d..%d step %d, out=%s, seed=%u, threads=%d\n",
+                   runs, sweep_from, sweep_to, sweep_step, out, seed, options.threads);
+            int rc = run_scramble_sweep(runs, sweep_from, sweep_to, sweep_step, out, seed, &options);
+            if (rc != 0) fprintf(stderr, "Benchmark failed (rc=%d)\n", rc);
+            return rc;
+        }
+
+        char scramble_name[16];
+        if (scramble == BENCHMARK_RANDOM_STATE) {
+            snprintf(scramble_name, sizeof(scramble_name), "random-state");
+        } else {
+            snprintf(scramble_name, sizeof(scramble_name), "%d", scramble);
+        }
+
+        if (duration > 0.0) {
+            printf("Running throughput benchmark: duration=%.3fs, scramble=%s, seed=%u, threads=%d\n", duration,
+                   scramble_name, seed, options.threads);
+            int rc = run_throughput_benchmark(duration, scramble, seed, &options);
+            if (rc != 0) fprintf(stderr, "Benchmark failed (rc=%d)\n", rc);
+            return rc;
+        }
+
+        printf("Running benchmark: runs=%d, scramble=%s, out=%s, seed=%u, threads=%d%s\n", runs, scramble_name, out,
+               seed, options.threads, quiet ? ", quiet" : "");
+        int rc = run_benchmark(runs, scramble, out, seed, quiet, &options, perf_counters);
         if (rc != 0) {
             fprintf(stderr, "Benchmark failed (rc=%d)\n", rc);
             return rc;
         }
         printf("Benchmark complete. Results saved to %s\n", out);
+        // Скрамблы совпадают с базовыми, только если тот прогон был с тем же --seed
+        if (baseline) return compare_benchmark(baseline, out, threshold);
         return 0;
     }
 
@@ -53,6 +152,40 @@ int main(int argc, char** argv) {
     return 0;
 } 
 
+// "10s", "500ms", "2m" или просто секунды; 0 - ошибка
+static double parse_duration(const char* text) {
+    char* end;
+    double value = strtod(text, &end);
+    if (end == text || value <= 0.0) return 0.0;
+    if (*end == '\0' || strcmp(end, "s") == 0) return value;
+    if (strcmp(end, "ms") == 0) return value / 1000.0;
+    if (strcmp(end, "m") == 0) return value * 60.0;
+    return 0.0;
+}
+
+// Список "ход=цена" через запятую, например "U2=3,D2=3,M=2"
+static bool parse_move_costs(SolverOptions* options, const char* spec) {
+    char buffer[256];
+    if (strlen(spec) >= sizeof(buffer)) return false;
+    strcpy(buffer, spec);
+
+    for (char* item = strtok(buffer, ","); item; item = strtok(NULL, ",")) {
+        char* eq = strchr(item, '=');
+        if (!eq) return false;
+        *eq = '\0';
+
+        Move move;
+        char* end;
+        long cost = strtol(eq + 1, &end, 10);
+        if (!move_from_string(item, &move) || *end != '\0' || cost < 0 || cost > 255) return false;
+        // Ход грани не может быть бесплатным - иначе поиск не ограничен по цене
+        if (move < MOVE_COUNT && cost == 0) return false;
+        options->move_cost[move] = (unsigned char)cost;
+    }
+    options->metric = SOLVER_METRIC_CUSTOM;
+    return true;
+}
+
 static void display_help_message(){
     printf("\n=== Rubik's Cube Controls ===\n");
     printf("Camera Controls:\n");
@@ -0,0 +1,80 @@
+#include "rng.h"
+
+static unsigned long long splitmix64(unsigned long long* state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static unsigned long long rotl(unsigned long long x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+void rng_seed(Rng* rng, unsigned long long seed) {
+    // splitmix64 не даёт четыре нуля подряд, так что состояние всегда рабочее
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+void rng_seed_stream(Rng* rng, unsigned long long seed, unsigned long long stream) {
+    // Номер потока сначала перемешивается, чтобы соседние потоки не шли со сдвигом
+    unsigned long long mixed = stream;
+    rng_seed(rng, seed ^ splitmix64(&mixed));
+}
+
+unsigned long long rng_next(Rng* rng) {
+    unsigned long long* s = rng->s;
+    unsigned long long result = rotl(s[1] * 5, 7) * 9;
+    unsigned long long t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+unsigned int rng_below(Rng* rng, unsigned int n) {
+    // Умножение вместо деления (Лемир); редкий отброс убирает смещение остатка
+    unsigned long long m = (rng_next(rng) >> 32) * n;
+    unsigned int low = (unsigned int)m;
+    if (low < n) {
+        unsigned int threshold = (0u - n) % n;
+        while (low < threshold) {
+            m = (rng_next(rng) >> 32) * n;
+            low = (unsigned int)m;
+        }
+    }
+    return (unsigned int)(m >> 32);
+}
+
+void rng_jump(Rng* rng) {
+    static const unsigned long long jump[4] = {
+        0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL
+    };
+    unsigned long long s[4] = {0, 0, 0, 0};
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (jump[i] & (1ULL << b)) {
+                s[0] ^= rng->s[0];
+                s[1] ^= rng->s[1];
+                s[2] ^= rng->s[2];
+                s[3] ^= rng->s[3];
+            }
+            rng_next(rng);
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = s[i];
+    }
+}
+
+Rng rng_split(Rng* rng) {
+    Rng child = *rng;
+    rng_jump(rng);
+    return child;
+}
@@ -0,0 +1,26 @@
+#ifndef RNG_H
+#define RNG_H
+
+/*
+    xoshiro256** (Blackman, Vigna): 256 бит состояния, период 2^256 - 1.
+    Результат зависит только от seed, а не от libc, поэтому скрамблы
+    одинаковы на Linux и Windows. Генератор не общий: у каждого потока или
+    прогона свой экземпляр, блокировок нет.
+*/
+typedef struct {
+    unsigned long long s[4];
+} Rng;
+
+// Fills the state from one 64-bit seed through splitmix64
+void rng_seed(Rng* rng, unsigned long long seed);
+// Independent stream number stream of the same seed (e.g. one per benchmark run)
+void rng_seed_stream(Rng* rng, unsigned long long seed, unsigned long long stream);
+unsigned long long rng_next(Rng* rng);
+// Unbiased number in [0, n), n > 0
+unsigned int rng_below(Rng* rng, unsigned int n);
+// Advances by 2^128 steps: equivalent to that many rng_next calls
+void rng_jump(Rng* rng);
+// Returns a generator for the next 2^128 numbers and jumps rng past them
+Rng rng_split(Rng* rng);
+
+#endif /* RNG_H */
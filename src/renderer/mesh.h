@@ -5,10 +5,7 @@
 #include <stdbool.h>
 
 #include "texture.h"
-
-typedef struct {
-    float r, g, b;
-} RGBColor;
+#include "../cube_state.h"
 
 typedef enum {
     FACE_FRONT  = 0x01,
@@ -8,6 +8,7 @@
 #include "../core/window.h"
 #include "../resources/embedded_shaders.h"
 #include "scene.h"
+#include "../solver/cube_solver.h"
 
 // Определение типа элемента по позиции
 static bool is_corner_piece(int x, int y, int z) {
@@ -152,7 +153,8 @@ bool scene_init_rubiks(Scene* scene) {
     scene->isRotating = false;
     scene->rotationAngle = 0.0f;
     scene->rotationTarget = 0.0f;
-    scene->rotatingLayer = 0;
+    scene->rotatingLayers = 0;
+    scene->rotatingMove = MOVE_U;
     scene->rotationAxis = 'y';
     scene->speedMultiplier = 1.0f; // Стандартная скороость по умолчанию
     scene->colorMode = false;
@@ -229,17 +231,15 @@ static void update_rotation(Scene* scene, float deltaTime) {
         scene->isRotating = false;
         scene->rotationAngle = 0.0f;
         
-        // Применяем вращение к цветам на кубе
-        for (int i = 0; i < scene->rotationRepetitions; i++) {
-            rotate_face_colors(scene->cubeColors, scene->rotatingFace, scene->rotationDirection);
+        // Применяем ход к цветам на кубе
+        apply_move_to_cube_colors(scene->cubeColors, scene->rotatingMove);
 
-            // Пересобираем куб
-            for (int i = 0; i < scene->numCubes; i++) {
-                mesh_destroy(&scene->cubes[i]);
-            }
-
-            create_textured_rubiks_cube_mesh(scene);(scene, scene->rotatingFace, scene->rotationDirection);
+        // Пересобираем куб
+        for (int i = 0; i < scene->numCubes; i++) {
+            mesh_destroy(&scene->cubes[i]);
         }
+
+        create_textured_rubiks_cube_mesh(scene);
     }
 }
 
@@ -291,11 +291,11 @@ void scene_render(Scene* scene, Window* window) {
         bool isRotatingCube = false;
         if (scene->isRotating) {
             if (scene->rotationAxis == 'x') {
-                isRotatingCube = (z == scene->rotatingLayer);
+                isRotatingCube = (scene->rotatingLayers >> z) & 1;
             } else if (scene->rotationAxis == 'y') {
-                isRotatingCube = (y == scene->rotatingLayer);
+                isRotatingCube = (scene->rotatingLayers >> y) & 1;
             } else if (scene->rotationAxis == 'z') {
-                isRotatingCube = (x == scene->rotatingLayer);
+                isRotatingCube = (scene->rotatingLayers >> x) & 1;
             }
         }
         
@@ -493,6 +493,16 @@ RGBColor* scene_get_cube_colors(Scene* scene) {
     return (RGBColor*)scene->cubeColors;
 }
 
+// Решатель не знает о сцене - ему передаются только цвета
+char** scene_solve_cube(Scene* scene, SolverContext* solver, bool* isSolved) {
+    if (!scene || !solver) {
+        printf("Error: Invalid scene\n");
+        return NULL;
+    }
+
+    return cube_solver_solve_ctx(solver, (const RGBColor (*)[9])scene->cubeColors, isSolved);
+}
+
 /* Операции с вращением */
 bool scene_is_rotating(Scene* scene) {
     return scene->isRotating;
@@ -500,288 +510,68 @@ bool scene_is_rotating(Scene* scene) {
 
 // Начать анимацию вращения
 void scene_start_rotation(Scene* scene, FaceIndex face, RotationDirection direction, int repetitions) {
+    scene_start_move(scene, get_move_from_face_and_direction(face, repetitions == 2 ? ROTATE_180 : direction));
+}
+
+void scene_start_move(Scene* scene, Move move) {
     if (scene->isRotating) {
         return; // Не начинать анимацию вращения если одна уже в процессе
     }
-    
+
+    FaceIndex face = move_to_face(move);
+    RotationDirection direction = move_to_direction(move);
+    int repetitions = 1;
+    if (direction == ROTATE_180) {
+        direction = ROTATE_CLOCKWISE;
+        repetitions = 2;
+    }
+
     scene->isRotating = true;
     scene->rotationAngle = 0.0f;
     scene->rotationTarget = 90.0f * repetitions;
-    scene->rotatingFace = face;
+    scene->rotatingMove = move;
     scene->rotationRepetitions = repetitions;
     
-    // Получаем слой кубов и направление вращание для каждой комбинации вращения и face
+    // Получаем ось и направление вращания для грани, вдоль которой идёт ход; у D, L и B слой грани - 0
+    bool lowSide = false;
     switch (face) {
         case FACE_IDX_TOP:
             scene->rotationAxis = 'y';
-            scene->rotatingLayer = 2;
             scene->rotationDirection = direction;
             break;
         case FACE_IDX_BOTTOM:
             scene->rotationAxis = 'y';
-            scene->rotatingLayer = 0;
             scene->rotationDirection = -direction;
+            lowSide = true;
             break;
         case FACE_IDX_RIGHT:
             scene->rotationAxis = 'x';
-            scene->rotatingLayer = 2;
             scene->rotationDirection = direction; 
             break;
         case FACE_IDX_LEFT:
             scene->rotationAxis = 'x';
-            scene->rotatingLayer = 0; 
             scene->rotationDirection = -direction;
+            lowSide = true;
             break;
         case FACE_IDX_FRONT:
             scene->rotationAxis = 'z';
-            scene->rotatingLayer = 2; 
             scene->rotationDirection = direction; 
             break;
         case FACE_IDX_BACK:
             scene->rotationAxis = 'z';
-            scene->rotatingLayer = 0;
             scene->rotationDirection = -direction; 
+            lowSide = true;
             break;
     }
-}
 
-// Повернуть цвета на face в направлении direction и соседние элементы к ним
-void rotate_face_colors(RGBColor (*cubeColors)[9], FaceIndex face, RotationDirection direction) {
-    RGBColor tempColors[6][9];
-    for (int f = 0; f < 6; f++) {
-        for (int p = 0; p < 9; p++) {
-            tempColors[f][p] = cubeColors[f][p];
+    // Слои хода считаются от его грани: срез - средний слой, широкий ход - два, поворот куба - все три
+    int layers = move_to_layers(move);
+    scene->rotatingLayers = 0;
+    for (int k = 0; k < 3; k++) {
+        if (layers & (1 << k)) {
+            scene->rotatingLayers |= 1 << (lowSide ? k : 2 - k);
         }
     }
-
-    if (face == FACE_IDX_TOP || face == FACE_IDX_BACK || face == FACE_IDX_RIGHT) direction = -direction;
-
-    // Поворот цветов на лицевой стороне
-    if (direction == ROTATE_CLOCKWISE) {  
-        cubeColors[face][0] = tempColors[face][6];
-        cubeColors[face][2] = tempColors[face][0];
-        cubeColors[face][8] = tempColors[face][2];
-        cubeColors[face][6] = tempColors[face][8];
-        
-        cubeColors[face][1] = tempColors[face][3];
-        cubeColors[face][5] = tempColors[face][1];
-        cubeColors[face][7] = tempColors[face][5];
-        cubeColors[face][3] = tempColors[face][7];
-    } else {       
-        cubeColors[face][0] = tempColors[face][2];
-        cubeColors[face][2] = tempColors[face][8];
-        cubeColors[face][8] = tempColors[face][6];
-        cubeColors[face][6] = tempColors[face][0];
-        
-        cubeColors[face][1] = tempColors[face][5];
-        cubeColors[face][5] = tempColors[face][7];
-        cubeColors[face][7] = tempColors[face][3];
-        cubeColors[face][3] = tempColors[face][1];
-    }
-    
-    if (face == FACE_IDX_TOP || face == FACE_IDX_BOTTOM || face == FACE_IDX_LEFT || face == FACE_IDX_RIGHT) direction = -direction;
-
-    switch (face) {
-        case FACE_IDX_TOP:
-            if (direction == ROTATE_CLOCKWISE) {
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_RIGHT][2-i] = tempColors[FACE_IDX_BACK][i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_BACK][2-i] = tempColors[FACE_IDX_LEFT][i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_LEFT][2-i] = tempColors[FACE_IDX_FRONT][i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_FRONT][2-i] = tempColors[FACE_IDX_RIGHT][i];
-                }
-            } else {
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_LEFT][2-i] = tempColors[FACE_IDX_BACK][i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_BACK][2-i] = tempColors[FACE_IDX_RIGHT][i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_RIGHT][2-i] = tempColors[FACE_IDX_FRONT][i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_FRONT][2-i] = tempColors[FACE_IDX_LEFT][i];
-                }
-            }
-            break;
-        case FACE_IDX_BOTTOM:
-            if (direction == ROTATE_CLOCKWISE) {
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_LEFT][2-i+6] = tempColors[FACE_IDX_BACK][6+i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_BACK][2-i+6] = tempColors[FACE_IDX_RIGHT][6+i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_RIGHT][2-i+6] = tempColors[FACE_IDX_FRONT][6+i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_FRONT][2-i+6] = tempColors[FACE_IDX_LEFT][6+i];
-                }
-            } else {
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_RIGHT][2-i+6] = tempColors[FACE_IDX_BACK][6+i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_BACK][2-i+6] = tempColors[FACE_IDX_LEFT][6+i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_LEFT][2-i+6] = tempColors[FACE_IDX_FRONT][6+i];
-                }
-                for (int i = 0; i < 3; i++) {
-                    cubeColors[FACE_IDX_FRONT][2-i+6] = tempColors[FACE_IDX_RIGHT][6+i];
-                }
-            }
-            break;
-        case FACE_IDX_FRONT:
-            if (direction == ROTATE_CLOCKWISE) {
-                cubeColors[FACE_IDX_RIGHT][8] = tempColors[FACE_IDX_TOP][2];
-                cubeColors[FACE_IDX_RIGHT][5] = tempColors[FACE_IDX_TOP][1];
-                cubeColors[FACE_IDX_RIGHT][2] = tempColors[FACE_IDX_TOP][0];
-                
-                cubeColors[FACE_IDX_BOTTOM][6] = tempColors[FACE_IDX_RIGHT][8];
-                cubeColors[FACE_IDX_BOTTOM][7] = tempColors[FACE_IDX_RIGHT][5];
-                cubeColors[FACE_IDX_BOTTOM][8] = tempColors[FACE_IDX_RIGHT][2];
-                
-                cubeColors[FACE_IDX_LEFT][6] = tempColors[FACE_IDX_BOTTOM][8];
-                cubeColors[FACE_IDX_LEFT][3] = tempColors[FACE_IDX_BOTTOM][7];
-                cubeColors[FACE_IDX_LEFT][0] = tempColors[FACE_IDX_BOTTOM][6];
-                
-                cubeColors[FACE_IDX_TOP][2] = tempColors[FACE_IDX_LEFT][0];
-                cubeColors[FACE_IDX_TOP][1] = tempColors[FACE_IDX_LEFT][3];
-                cubeColors[FACE_IDX_TOP][0] = tempColors[FACE_IDX_LEFT][6];
-            } else {
-                cubeColors[FACE_IDX_LEFT][0] = tempColors[FACE_IDX_TOP][2];
-                cubeColors[FACE_IDX_LEFT][3] = tempColors[FACE_IDX_TOP][1];
-                cubeColors[FACE_IDX_LEFT][6] = tempColors[FACE_IDX_TOP][0];
-                
-                cubeColors[FACE_IDX_BOTTOM][6] = tempColors[FACE_IDX_LEFT][0];
-                cubeColors[FACE_IDX_BOTTOM][7] = tempColors[FACE_IDX_LEFT][3];
-                cubeColors[FACE_IDX_BOTTOM][8] = tempColors[FACE_IDX_LEFT][6];
-                
-                cubeColors[FACE_IDX_RIGHT][2] = tempColors[FACE_IDX_BOTTOM][8];
-                cubeColors[FACE_IDX_RIGHT][5] = tempColors[FACE_IDX_BOTTOM][7];
-                cubeColors[FACE_IDX_RIGHT][8] = tempColors[FACE_IDX_BOTTOM][6];
-                
-                cubeColors[FACE_IDX_TOP][2] = tempColors[FACE_IDX_RIGHT][8];
-                cubeColors[FACE_IDX_TOP][1] = tempColors[FACE_IDX_RIGHT][5];
-                cubeColors[FACE_IDX_TOP][0] = tempColors[FACE_IDX_RIGHT][2];
-            }
-            break;
-        case FACE_IDX_BACK:
-            if (direction == ROTATE_CLOCKWISE) {                
-                cubeColors[FACE_IDX_LEFT][2] = tempColors[FACE_IDX_TOP][8];
-                cubeColors[FACE_IDX_LEFT][5] = tempColors[FACE_IDX_TOP][7];
-                cubeColors[FACE_IDX_LEFT][8] = tempColors[FACE_IDX_TOP][6];
-
-                cubeColors[FACE_IDX_BOTTOM][0] = tempColors[FACE_IDX_LEFT][2];
-                cubeColors[FACE_IDX_BOTTOM][1] = tempColors[FACE_IDX_LEFT][5];
-                cubeColors[FACE_IDX_BOTTOM][2] = tempColors[FACE_IDX_LEFT][8];
-                
-                cubeColors[FACE_IDX_RIGHT][6] = tempColors[FACE_IDX_BOTTOM][0];
-                cubeColors[FACE_IDX_RIGHT][3] = tempColors[FACE_IDX_BOTTOM][1];
-                cubeColors[FACE_IDX_RIGHT][0] = tempColors[FACE_IDX_BOTTOM][2];
-                
-                cubeColors[FACE_IDX_TOP][6] = tempColors[FACE_IDX_RIGHT][0];
-                cubeColors[FACE_IDX_TOP][7] = tempColors[FACE_IDX_RIGHT][3];
-                cubeColors[FACE_IDX_TOP][8] = tempColors[FACE_IDX_RIGHT][6];
-            } else {
-                cubeColors[FACE_IDX_RIGHT][0] = tempColors[FACE_IDX_TOP][6];
-                cubeColors[FACE_IDX_RIGHT][3] = tempColors[FACE_IDX_TOP][7];
-                cubeColors[FACE_IDX_RIGHT][6] = tempColors[FACE_IDX_TOP][8];
-                
-                cubeColors[FACE_IDX_BOTTOM][2] = tempColors[FACE_IDX_RIGHT][0];
-                cubeColors[FACE_IDX_BOTTOM][1] = tempColors[FACE_IDX_RIGHT][3];
-                cubeColors[FACE_IDX_BOTTOM][0] = tempColors[FACE_IDX_RIGHT][6];
-                
-                cubeColors[FACE_IDX_LEFT][8] = tempColors[FACE_IDX_BOTTOM][2];
-                cubeColors[FACE_IDX_LEFT][5] = tempColors[FACE_IDX_BOTTOM][1];
-                cubeColors[FACE_IDX_LEFT][2] = tempColors[FACE_IDX_BOTTOM][0];
-            
-                cubeColors[FACE_IDX_TOP][8] = tempColors[FACE_IDX_LEFT][2];
-                cubeColors[FACE_IDX_TOP][7] = tempColors[FACE_IDX_LEFT][5];
-                cubeColors[FACE_IDX_TOP][6] = tempColors[FACE_IDX_LEFT][8];
-            }
-            break;
-        case FACE_IDX_LEFT:
-            if (direction == ROTATE_CLOCKWISE) {
-                cubeColors[FACE_IDX_FRONT][0] = tempColors[FACE_IDX_TOP][6];
-                cubeColors[FACE_IDX_FRONT][3] = tempColors[FACE_IDX_TOP][3];
-                cubeColors[FACE_IDX_FRONT][6] = tempColors[FACE_IDX_TOP][0];
-                
-                cubeColors[FACE_IDX_BOTTOM][0] = tempColors[FACE_IDX_FRONT][6];
-                cubeColors[FACE_IDX_BOTTOM][3] = tempColors[FACE_IDX_FRONT][3];
-                cubeColors[FACE_IDX_BOTTOM][6] = tempColors[FACE_IDX_FRONT][0];
-                
-                cubeColors[FACE_IDX_BACK][2] = tempColors[FACE_IDX_BOTTOM][0];
-                cubeColors[FACE_IDX_BACK][5] = tempColors[FACE_IDX_BOTTOM][3];
-                cubeColors[FACE_IDX_BACK][8] = tempColors[FACE_IDX_BOTTOM][6];
-                
-                cubeColors[FACE_IDX_TOP][0] = tempColors[FACE_IDX_BACK][2];
-                cubeColors[FACE_IDX_TOP][3] = tempColors[FACE_IDX_BACK][5];
-                cubeColors[FACE_IDX_TOP][6] = tempColors[FACE_IDX_BACK][8];
-            } else {
-                cubeColors[FACE_IDX_BACK][8] = tempColors[FACE_IDX_TOP][6];
-                cubeColors[FACE_IDX_BACK][5] = tempColors[FACE_IDX_TOP][3];
-                cubeColors[FACE_IDX_BACK][2] = tempColors[FACE_IDX_TOP][0];
-                
-                cubeColors[FACE_IDX_BOTTOM][0] = tempColors[FACE_IDX_BACK][2];
-                cubeColors[FACE_IDX_BOTTOM][3] = tempColors[FACE_IDX_BACK][5];
-                cubeColors[FACE_IDX_BOTTOM][6] = tempColors[FACE_IDX_BACK][8];
-                
-                cubeColors[FACE_IDX_FRONT][0] = tempColors[FACE_IDX_BOTTOM][6];
-                cubeColors[FACE_IDX_FRONT][3] = tempColors[FACE_IDX_BOTTOM][3];
-                cubeColors[FACE_IDX_FRONT][6] = tempColors[FACE_IDX_BOTTOM][0];
-                
-                cubeColors[FACE_IDX_TOP][0] = tempColors[FACE_IDX_FRONT][6];
-                cubeColors[FACE_IDX_TOP][3] = tempColors[FACE_IDX_FRONT][3];
-                cubeColors[FACE_IDX_TOP][6] = tempColors[FACE_IDX_FRONT][0];
-            }
-            break;
-        case FACE_IDX_RIGHT:
-            if (direction == ROTATE_CLOCKWISE) {                
-                cubeColors[FACE_IDX_BACK][6] = tempColors[FACE_IDX_TOP][8];
-                cubeColors[FACE_IDX_BACK][3] = tempColors[FACE_IDX_TOP][5];
-                cubeColors[FACE_IDX_BACK][0] = tempColors[FACE_IDX_TOP][2];
-                
-                cubeColors[FACE_IDX_BOTTOM][2] = tempColors[FACE_IDX_BACK][0];
-                cubeColors[FACE_IDX_BOTTOM][5] = tempColors[FACE_IDX_BACK][3];
-                cubeColors[FACE_IDX_BOTTOM][8] = tempColors[FACE_IDX_BACK][6];
-                
-                cubeColors[FACE_IDX_FRONT][2] = tempColors[FACE_IDX_BOTTOM][8];
-                cubeColors[FACE_IDX_FRONT][5] = tempColors[FACE_IDX_BOTTOM][5];
-                cubeColors[FACE_IDX_FRONT][8] = tempColors[FACE_IDX_BOTTOM][2];
-                
-                cubeColors[FACE_IDX_TOP][2] = tempColors[FACE_IDX_FRONT][8];
-                cubeColors[FACE_IDX_TOP][5] = tempColors[FACE_IDX_FRONT][5];
-                cubeColors[FACE_IDX_TOP][8] = tempColors[FACE_IDX_FRONT][2];
-
-            } else {
-                cubeColors[FACE_IDX_FRONT][2] = tempColors[FACE_IDX_TOP][8];
-                cubeColors[FACE_IDX_FRONT][5] = tempColors[FACE_IDX_TOP][5];
-                cubeColors[FACE_IDX_FRONT][8] = tempColors[FACE_IDX_TOP][2];
-                
-                cubeColors[FACE_IDX_BOTTOM][2] = tempColors[FACE_IDX_FRONT][8];
-                cubeColors[FACE_IDX_BOTTOM][5] = tempColors[FACE_IDX_FRONT][5];
-                cubeColors[FACE_IDX_BOTTOM][8] = tempColors[FACE_IDX_FRONT][2];
-                
-                cubeColors[FACE_IDX_BACK][6] = tempColors[FACE_IDX_BOTTOM][8];
-                cubeColors[FACE_IDX_BACK][3] = tempColors[FACE_IDX_BOTTOM][5];
-                cubeColors[FACE_IDX_BACK][0] = tempColors[FACE_IDX_BOTTOM][2];
-                
-                cubeColors[FACE_IDX_TOP][8] = tempColors[FACE_IDX_BACK][6];
-                cubeColors[FACE_IDX_TOP][5] = tempColors[FACE_IDX_BACK][3];
-                cubeColors[FACE_IDX_TOP][2] = tempColors[FACE_IDX_BACK][0];
-            }
-            break;
-    }
 }
 
 
@@ -846,43 +636,20 @@ void scene_add_move_to_queue(Scene* scene, const char* move) {
     scene->moveQueueSize++;
 }
 
-// Функция чтобы извлечь direction и face из строчки хода
-static bool parse_move_string(const char* moveStr, FaceIndex* face, RotationDirection* direction, int* repetitions) {
+// Функция чтобы извлечь ход из строчки: грани, срезы M/E/S, широкие (Rw) и повороты x/y/z
+static bool parse_move_string(const char* moveStr, Move* move) {
     if (!moveStr || strlen(moveStr) == 0) return false;
     
-    *repetitions = 1;
-    *direction = ROTATE_CLOCKWISE;
-    
-    char faceChar = moveStr[0];
-    switch (faceChar) {
-        case 'U': case 'u': *face = FACE_IDX_TOP; break;
-        case 'D': case 'd': *face = FACE_IDX_BOTTOM; break;
-        case 'F': case 'f': *face = FACE_IDX_FRONT; break;
-        case 'B': case 'b': *face = FACE_IDX_BACK; break;
-        case 'R': case 'r': *face = FACE_IDX_RIGHT; break;
-        case 'L': case 'l': *face = FACE_IDX_LEFT; break;
-        default: return false;
-    }
-    
-    for (size_t i = 1; i < strlen(moveStr); i++) {
-        char modifier = moveStr[i];
-        if (modifier == '\'' || modifier == '\'') {
-            *direction = ROTATE_COUNTERCLOCKWISE;
-        } else if (modifier == '2') {
-            *repetitions = 2;
-        }
-    }
-    
-    return true;
+    return move_from_string(moveStr, move);
 }
 
 // Функция чтобы получить обратный ход ( для возврата в режиме по ходам)
-static bool get_inverse_move(const char* moveStr, FaceIndex* face, RotationDirection* direction, int* repetitions) {
-    if (!parse_move_string(moveStr, face, direction, repetitions)) {
+static bool get_inverse_move(const char* moveStr, Move* move) {
+    if (!parse_move_string(moveStr, move)) {
         return false;
     }
     
-    *direction = (*direction == ROTATE_CLOCKWISE) ? ROTATE_COUNTERCLOCKWISE : ROTATE_CLOCKWISE;
+    *move = move_inverse(*move);
     
     return true;
 }
@@ -896,16 +663,14 @@ void scene_process_move_queue(Scene* scene) {
     // Если сей1час аниманиця поворота не играет, начинаем поворот следующего 
     if (!scene->isRotating) {
         const char* moveStr = scene->moveQueue[scene->currentMoveIndex];
-        FaceIndex face;
-        RotationDirection direction;
-        int repetitions;
+        Move move;
         
-        if (parse_move_string(moveStr, &face, &direction, &repetitions)) {
+        if (parse_move_string(moveStr, &move)) {
             printf("Executing move %d/%d: %s\n", 
                    scene->currentMoveIndex + 1, scene->moveQueueSize, moveStr);
             
             // Запускаем анимацию
-            scene_start_rotation(scene, face, direction, repetitions);
+            scene_start_move(scene, move);
             scene->currentMoveIndex++;
             
             // Если ходы кончились очищаем очередь и сбрасываем скорость
@@ -1002,15 +767,13 @@ void scene_browse_next(Scene* scene) {
     }
     
     const char* currentMoveStr = scene->moveQueue[scene->browseIndex];
-    FaceIndex face;
-    RotationDirection direction;
-    int repetitions;
+    Move move;
     
-    if (parse_move_string(currentMoveStr, &face, &direction, &repetitions)) {
+    if (parse_move_string(currentMoveStr, &move)) {
         printf("Applying move [%d/%d]: %s\n", 
                scene->browseIndex + 1, scene->moveQueueSize, currentMoveStr);
         
-        scene_start_rotation(scene, face, direction, repetitions);
+        scene_start_move(scene, move);
     }
     
     scene->browseIndex++;
@@ -1036,15 +799,13 @@ void scene_browse_previous(Scene* scene) {
     scene->browseIndex--;
     
     const char* moveToUndo = scene->moveQueue[scene->browseIndex];
-    FaceIndex face;
-    RotationDirection direction;
-    int repetitions;
+    Move move;
     
-    if (get_inverse_move(moveToUndo, &face, &direction, &repetitions)) {
+    if (get_inverse_move(moveToUndo, &move)) {
         printf("Undoing move [%d/%d]: %s (applying inverse)\n", 
                scene->browseIndex + 1, scene->moveQueueSize, moveToUndo);
         
-        scene_start_rotation(scene, face, direction, repetitions);
+        scene_start_move(scene, move);
     }
     
     printf("Now at move [%d/%d]: %s\n", scene->browseIndex + 1, scene->moveQueueSize, 
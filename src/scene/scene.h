@@ -6,6 +6,8 @@
 #include "../renderer/mesh.h"
 #include "../math/mat4.h"
 #include "../types.h"
+#include "../cube_state.h"
+#include "../solver/cube_solver.h"
 #include "../core/window.h"
 // Color mapping for Rubik's cube faces
 typedef enum {
@@ -17,23 +19,6 @@ typedef enum {
     CUBE_COLOR_GREEN = 'G'    // Left face (L)
 } CubeColor;
 
-// Face indices for a Rubik's cube
-typedef enum {
-    FACE_IDX_TOP = 0,    // U - White
-    FACE_IDX_FRONT = 1,  // F - Red
-    FACE_IDX_RIGHT = 2,  // R - Blue 
-    FACE_IDX_BACK = 3,   // B - Orange
-    FACE_IDX_LEFT = 4,   // L - Green
-    FACE_IDX_BOTTOM = 5  // D - Yellow
-} FaceIndex;
-
-// Rotation direction
-typedef enum {
-    ROTATE_CLOCKWISE = 1,
-    ROTATE_COUNTERCLOCKWISE = -1,
-    ROTATE_180 = 2
-} RotationDirection;
-
 struct Scene {
     Shader shader;
     
@@ -46,9 +31,9 @@ struct Scene {
     bool isRotating;
     float rotationAngle;
     float rotationTarget;
-    FaceIndex rotatingFace;
+    Move rotatingMove;     // Ход, который применится к цветам в конце анимации
     RotationDirection rotationDirection;
-    int rotatingLayer;     // 0, 1, 2
+    int rotatingLayers;    // Маска слоёв вдоль rotationAxis: бит k - слой k (0, 1, 2)
     char rotationAxis;     // 'x', 'y', or 'z'
     int rotationRepetitions; 
     float speedMultiplier;   
@@ -81,10 +66,13 @@ bool scene_set_cube_state_from_string(Scene* scene, const char* state);
 
 char* scene_get_cube_state_as_string(RGBColor (*cubeColors)[9]);
 RGBColor* scene_get_cube_colors(Scene* scene);
-void rotate_face_colors(RGBColor (*cubeColors)[9], FaceIndex face, RotationDirection direction);
+// Solves the scene's cube in the given solver context; NULL-terminated, caller-owned
+char** scene_solve_cube(Scene* scene, SolverContext* solver, bool* isSolved);
 
 
 void scene_start_rotation(Scene* scene, FaceIndex face, RotationDirection direction, int repetitions);
+// Animates any move, slices, wide moves and whole-cube rotations included, as a single turn
+void scene_start_move(Scene* scene, Move move);
 
 bool scene_is_rotating(Scene* scene);
 
@@ -1,10 +1,21 @@
 #include "cube_solver.h"
 #include "oll.h"
+#include "cubie_cube.h"
+#include "move_tables.h"
+#include "f2l_table.h"
+#include "xcross.h"
+#include "move_optimizer.h"
+#include "solver_arena.h"
+#include "cube_validate.h"
+#include "solver_cache.h"
 #include <stdio.h>
 #include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <stdatomic.h>
 
 static int index_array(int value, int* array){
     for (int k = 0; k < 4; ++k) {
@@ -15,17 +26,122 @@ static int index_array(int value, int* array){
     return -1;
 }
 
-// Quiet logging for solver
-static bool g_solver_quiet = false;
-void cube_solver_set_quiet(bool quiet) { g_solver_quiet = quiet; }
-static int solver_printf(const char* fmt, ...) {
-    if (g_solver_quiet) return 0;
-    va_list ap; va_start(ap, fmt);
-    int r = vprintf(fmt, ap);
+void solver_options_init(SolverOptions* options) {
+    options->multislot = false;
+    options->xcross = false;
+    options->window = false;
+    options->stitching = true;
+    options->threads = 1;
+    options->cache_bytes = 0;
+    solver_options_set_metric(options, SOLVER_METRIC_HTM);
+}
+
+void solver_options_set_metric(SolverOptions* options, SolverMetric metric) {
+    options->metric = metric;
+    if (metric == SOLVER_METRIC_CUSTOM) return;
+
+    for (int m = 0; m < MOVE_EXTENDED_COUNT; m++) {
+        int layers = move_layers_table[m];
+        int cost;
+        if (layers == 7) {
+            cost = 0; // Поворот всего куба
+        } else if (metric == SOLVER_METRIC_STM) {
+            cost = 1;
+        } else {
+            cost = (metric == SOLVER_METRIC_QTM && move_quarters_table[m] == 2) ? 2 : 1;
+            // Срез в метриках граней - это два поворота противоположных граней
+            if (layers == 2) cost *= 2;
+        }
+        options->move_cost[m] = (unsigned char)cost;
+    }
+}
+
+const char* solver_stage_name(SolverStageId stage) {
+    static const char* const names[SOLVER_STAGE_COUNT] = {"cross", "f2l", "oll", "pll", "fix_lower", "simplify"};
+    if ((unsigned)stage >= SOLVER_STAGE_COUNT) return "?";
+    return names[stage];
+}
+
+const char* solver_metric_name(SolverMetric metric) {
+    switch (metric) {
+        case SOLVER_METRIC_HTM: return "htm";
+        case SOLVER_METRIC_QTM: return "qtm";
+        case SOLVER_METRIC_STM: return "stm";
+        case SOLVER_METRIC_CUSTOM: return "custom";
+    }
+    return "?";
+}
+
+bool solver_metric_from_string(const char* text, SolverMetric* metric) {
+    static const SolverMetric metrics[] = {SOLVER_METRIC_HTM, SOLVER_METRIC_QTM, SOLVER_METRIC_STM, SOLVER_METRIC_CUSTOM};
+    if (!text) return false;
+    for (size_t i = 0; i < sizeof(metrics) / sizeof(metrics[0]); i++) {
+        if (strcmp(text, solver_metric_name(metrics[i])) == 0) {
+            *metric = metrics[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+int solver_move_cost(const SolverOptions* options, Move move) {
+    if ((unsigned)move >= MOVE_EXTENDED_COUNT) return 0;
+    return options->move_cost[move];
+}
+
+int solver_sequence_cost(const SolverOptions* options, const Move* moves, int count) {
+    int cost = 0;
+    for (int i = 0; i < count; i++) {
+        cost += solver_move_cost(options, moves[i]);
+    }
+    return cost;
+}
+
+void solver_log_stdout(void* user, const char* message) {
+    (void)user;
+    fputs(message, stdout);
+}
+
+// Первая сборка иначе строила бы таблицы внутри своего замера (XCross - около 1.5 с), а другие потоки ждали бы её
+void solver_warm_up(const SolverOptions* options) {
+    f2l_init();
+    if (options && options->xcross) xcross_init();
+    if (options && options->window) move_optimizer_init();
+}
+
+void solver_context_init(SolverContext* ctx, const SolverOptions* options) {
+    if (options) {
+        ctx->options = *options;
+    } else {
+        solver_options_init(&ctx->options);
+    }
+    solver_warm_up(&ctx->options);
+    ctx->log = solver_log_stdout;
+    ctx->log_user = NULL;
+    solver_arena_init(&ctx->arena);
+    memset(&ctx->stats, 0, sizeof(ctx->stats));
+    memset(&ctx->stage_stats, 0, sizeof(ctx->stage_stats));
+    ctx->cache = ctx->options.cache_bytes > 0 ? solver_cache_create(ctx->options.cache_bytes) : NULL;
+    ctx->owns_cache = ctx->cache != NULL;
+}
+
+void solver_context_destroy(SolverContext* ctx) {
+    solver_arena_destroy(&ctx->arena);
+    if (ctx->owns_cache) solver_cache_destroy(ctx->cache);
+    ctx->cache = NULL;
+}
+
+// Лог сборки уходит в приёмник контекста; без приёмника сообщения даже не форматируются
+static void solver_log(const SolverContext* ctx, const char* fmt, ...) {
+    if (!ctx->log) return;
+
+    char message[256];
+    va_list ap;
+    va_start(ap, fmt);
+    vsnprintf(message, sizeof(message), fmt, ap);
     va_end(ap);
-    return r;
+    ctx->log(ctx->log_user, message);
 }
-#define printf(...) solver_printf(__VA_ARGS__)
 
 // Сравнение цветов с погрешностью
 static bool colors_equal(RGBColor a, RGBColor b) {
@@ -73,21 +189,42 @@ void move_sequence_init(MoveSequence* sequence) {
     sequence->moves = NULL;
     sequence->count = 0;
     sequence->capacity = 0;
+    sequence->arena = NULL;
 }
 
-void move_sequence_add(MoveSequence* sequence, Move move, RGBColor (*cubeColors)[9]) {
-
-    apply_move_to_cube_colors(cubeColors, move);
+// Последовательность, которая растёт в арене и живёт до её сброса
+static void move_sequence_init_scratch(SolverContext* ctx, MoveSequence* sequence) {
+    move_sequence_init(sequence);
+    sequence->arena = &ctx->arena;
+}
 
+// Дописывает ход, не трогая цвета
+static void move_sequence_push(MoveSequence* sequence, Move move) {
     if (sequence->count >= sequence->capacity) {
-        sequence->capacity = sequence->capacity == 0 ? 16 : sequence->capacity * 2;
-        sequence->moves = realloc(sequence->moves, sequence->capacity * sizeof(Move));
+        int capacity = sequence->capacity == 0 ? 16 : sequence->capacity * 2;
+        if (sequence->arena) {
+            // Старый буфер остаётся в арене до сброса
+            Move* moves = solver_arena_alloc(sequence->arena, capacity * sizeof(Move));
+            // Ход теряется, а сборку проваливает отметка failed в арене
+            if (!moves) return;
+            if (sequence->count > 0) memcpy(moves, sequence->moves, sequence->count * sizeof(Move));
+            sequence->moves = moves;
+            sequence->capacity = capacity;
+        } else {
+            sequence->capacity = capacity;
+            sequence->moves = realloc(sequence->moves, sequence->capacity * sizeof(Move));
+        }
     }
     sequence->moves[sequence->count++] = move;
 }
 
+void move_sequence_add(MoveSequence* sequence, Move move, RGBColor (*cubeColors)[9]) {
+    apply_move_to_cube_colors(cubeColors, move);
+    move_sequence_push(sequence, move);
+}
+
 void move_sequence_destroy(MoveSequence* sequence) {
-    if (sequence->moves) {
+    if (sequence->moves && !sequence->arena) {
         free(sequence->moves);
         sequence->moves = NULL;
     }
@@ -103,128 +240,77 @@ void move_sequence_print(const MoveSequence* sequence) {
     printf("\n");
 }
 
-static int rotation_to_quarters(RotationDirection dir) {
-    if (dir == ROTATE_CLOCKWISE) return 1;
-    if (dir == ROTATE_COUNTERCLOCKWISE) return -1;
-    return 2;
-}
-
-static void simplify_move_sequence(MoveSequence* sequence) {
+void simplify_move_sequence(const SolverContext* ctx, MoveSequence* sequence) {
     if (!sequence || sequence->count <= 1) return;
 
-    Move* out = (Move*)malloc(sequence->count * sizeof(Move));
-    if (!out) return;
+    sequence->count = move_optimizer_merge(sequence->moves, sequence->count);
+    if (ctx->options.window) {
+        sequence->count = move_optimizer_window(sequence->moves, sequence->count, ctx->options.move_cost);
+    }
+}
+
+// Имена, грани, четверти и слои ходов - из сгенерированных таблиц (tools/gen_move_tables.c)
+const char* move_to_string(Move move) {
+    if ((unsigned)move >= MOVE_EXTENDED_COUNT) return "?";
+    return move_name_table[move];
+}
 
-    int out_count = 0;
-    for (int i = 0; i < sequence->count; ++i) {
-        Move m = sequence->moves[i];
-        if (out_count > 0 && move_to_face(out[out_count - 1]) == move_to_face(m)) {
-            int q1 = rotation_to_quarters(move_to_direction(out[out_count - 1]));
-            int q2 = rotation_to_quarters(move_to_direction(m));
-            int q = (q1 + q2) % 4;
-            if (q < 0) q += 4;
+bool move_from_string(const char* text, Move* move) {
+    if (!text || !text[0]) return false;
 
-            if (q == 0) {
-                out_count--;
-            } else {
-                RotationDirection ndir = (q == 1) ? ROTATE_CLOCKWISE : (q == 2) ? ROTATE_180 : ROTATE_COUNTERCLOCKWISE;
-                FaceIndex f = move_to_face(m);
-                out[out_count - 1] = get_move_from_face_and_direction(f, ndir);
-            }
-        } else {
-            out[out_count++] = m;
-        }
+    // Строчные буквы граней - обычные ходы граней, как и раньше; x, y, z - только строчные
+    char name[4] = {text[0], '\0'};
+    if (strchr("udfbrl", name[0])) name[0] = (char)(name[0] - 'a' + 'A');
+    size_t length = 1;
+    size_t pos = 1;
+    if (text[pos] == 'w' && strchr("UDFBRL", name[0])) {
+        name[length++] = text[pos++];
     }
 
-    free(sequence->moves);
-    sequence->moves = out;
-    sequence->count = out_count;
-    sequence->capacity = out_count;
-}
+    // Суффиксы 2 и ' в любом порядке: 2' и '2 - тоже пол-оборота
+    bool half = false, prime = false;
+    for (; text[pos]; pos++) {
+        if (text[pos] == '2') half = true;
+        else if (text[pos] == '\'') prime = true;
+        else return false;
+    }
+    if (half) name[length++] = '2';
+    else if (prime) name[length++] = '\'';
+    name[length] = '\0';
 
-const char* move_to_string(Move move) {
-    switch (move) {
-        case MOVE_U: return "U";
-        case MOVE_U_PRIME: return "U'";
-        case MOVE_U2: return "U2";
-        case MOVE_D: return "D";
-        case MOVE_D_PRIME: return "D'";
-        case MOVE_D2: return "D2";
-        case MOVE_F: return "F";
-        case MOVE_F_PRIME: return "F'";
-        case MOVE_F2: return "F2";
-        case MOVE_B: return "B";
-        case MOVE_B_PRIME: return "B'";
-        case MOVE_B2: return "B2";
-        case MOVE_R: return "R";
-        case MOVE_R_PRIME: return "R'";
-        case MOVE_R2: return "R2";
-        case MOVE_L: return "L";
-        case MOVE_L_PRIME: return "L'";
-        case MOVE_L2: return "L2";
-        default: return "?";
+    for (int m = 0; m < MOVE_EXTENDED_COUNT; m++) {
+        if (strcmp(move_name_table[m], name) == 0) {
+            *move = (Move)m;
+            return true;
+        }
     }
+    return false;
 }
 
 FaceIndex move_to_face(Move move) {
-    switch (move) {
-        case MOVE_U:
-        case MOVE_U_PRIME:
-        case MOVE_U2:
-            return FACE_IDX_TOP;
-        case MOVE_D:
-        case MOVE_D_PRIME:
-        case MOVE_D2:
-            return FACE_IDX_BOTTOM;
-        case MOVE_F:
-        case MOVE_F_PRIME:
-        case MOVE_F2:
-            return FACE_IDX_FRONT;
-        case MOVE_B:
-        case MOVE_B_PRIME:
-        case MOVE_B2:
-            return FACE_IDX_BACK;
-        case MOVE_R:
-        case MOVE_R_PRIME:
-        case MOVE_R2:
-            return FACE_IDX_RIGHT;
-        case MOVE_L:
-        case MOVE_L_PRIME:
-        case MOVE_L2:
-            return FACE_IDX_LEFT;
-        default:
-            return FACE_IDX_TOP; // fallback
-    }
+    if ((unsigned)move >= MOVE_EXTENDED_COUNT) return FACE_IDX_TOP; // fallback
+    return (FaceIndex)move_face_table[move];
 }
 
 RotationDirection move_to_direction(Move move) {
-    switch (move) {
-        case MOVE_U:
-        case MOVE_D:
-        case MOVE_F:
-        case MOVE_B:
-        case MOVE_R:
-        case MOVE_L:
-            return ROTATE_CLOCKWISE;
-        case MOVE_U_PRIME:
-        case MOVE_D_PRIME:
-        case MOVE_F_PRIME:
-        case MOVE_B_PRIME:
-        case MOVE_R_PRIME:
-        case MOVE_L_PRIME:
-            return ROTATE_COUNTERCLOCKWISE;
-        case MOVE_U2:
-        case MOVE_D2:
-        case MOVE_F2:
-        case MOVE_B2:
-        case MOVE_R2:
-        case MOVE_L2:
-            return ROTATE_180;
-        default:
-            return ROTATE_CLOCKWISE; 
+    if ((unsigned)move >= MOVE_EXTENDED_COUNT) return ROTATE_CLOCKWISE;
+    switch (move_quarters_table[move]) {
+        case 2: return ROTATE_180;
+        case 3: return ROTATE_COUNTERCLOCKWISE;
+        default: return ROTATE_CLOCKWISE;
     }
 }
 
+int move_to_layers(Move move) {
+    if ((unsigned)move >= MOVE_EXTENDED_COUNT) return 0;
+    return move_layers_table[move];
+}
+
+Move move_inverse(Move move) {
+    if ((unsigned)move >= MOVE_EXTENDED_COUNT) return move;
+    return (Move)move_inverse_table[move];
+}
+
 Move get_move_from_face_and_direction(FaceIndex face, RotationDirection direction) {
     switch (face) {
         case FACE_IDX_TOP:
@@ -244,20 +330,45 @@ Move get_move_from_face_and_direction(FaceIndex face, RotationDirection directio
     }
 }
 
-void apply_move_to_cube_colors(RGBColor (*cubeColors)[9], Move move) {
-    FaceIndex face = move_to_face(move);
-
-    RotationDirection direction = move_to_direction(move);
-    if ((face == FACE_IDX_BOTTOM || face == FACE_IDX_BACK || face == FACE_IDX_LEFT) && direction != ROTATE_180){
+// Повернуть цвета на face в направлении direction и соседние элементы к ним
+void rotate_face_colors(RGBColor (*cubeColors)[9], FaceIndex face, RotationDirection direction) {
+    // У D, B и L направление поворота грани зеркально направлению хода
+    if ((face == FACE_IDX_BOTTOM || face == FACE_IDX_BACK || face == FACE_IDX_LEFT) && direction != ROTATE_180) {
         direction = -direction;
     }
-    if (direction == ROTATE_180){
-        direction = ROTATE_CLOCKWISE;
-        rotate_face_colors(cubeColors, face, direction);
-        rotate_face_colors(cubeColors, face, direction);
+    apply_move_to_cube_colors(cubeColors, get_move_from_face_and_direction(face, direction));
+}
+
+// Счётчик своего потока: бенчмарк пропускной способности считает им ходы без синхронизации
+static _Thread_local unsigned long long g_applied_moves = 0;
+
+unsigned long long solver_applied_moves(void) {
+    return g_applied_moves;
+}
+
+// Ход - перестановка наклеек из сгенерированной таблицы (tools/gen_move_tables.c); у ходов граней трогаем только 20 изменившихся
+void apply_move_to_cube_colors(RGBColor (*cubeColors)[9], Move move) {
+    g_applied_moves++;
+    RGBColor* facelets = &cubeColors[0][0];
+    if (move >= MOVE_COUNT) {
+        // Срезы, широкие ходы и повороты куба - полная перестановка
+        if ((unsigned)move >= MOVE_EXTENDED_COUNT) return;
+        RGBColor before[MOVE_TABLES_FACELETS];
+        memcpy(before, facelets, sizeof(before));
+        for (int i = 0; i < MOVE_TABLES_FACELETS; i++) {
+            facelets[i] = before[facelet_move_src[move][i]];
+        }
+        return;
+    }
+
+    const unsigned char (*moved)[2] = facelet_move_moved[move];
+
+    RGBColor before[MOVE_TABLES_MOVED];
+    for (int k = 0; k < MOVE_TABLES_MOVED; k++) {
+        before[k] = facelets[moved[k][1]];
     }
-    else {
-        rotate_face_colors(cubeColors, face, direction);
+    for (int k = 0; k < MOVE_TABLES_MOVED; k++) {
+        facelets[moved[k][0]] = before[k];
     }
 }
 
@@ -281,34 +392,13 @@ bool is_cube_solved(const RGBColor (*cubeColors)[9]) {
     return true;
 }
 
-static bool find_edge_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RGBColor color2,
-                            FaceIndex* face1, int* pos1, FaceIndex* face2, int* pos2) {
-    static const struct {
-        FaceIndex face1, pos1, face2, pos2;
-    } edge_map[] = {
-        {FACE_IDX_TOP, 1, FACE_IDX_FRONT, 1},
-        {FACE_IDX_TOP, 3, FACE_IDX_LEFT, 1},
-        {FACE_IDX_TOP, 5, FACE_IDX_RIGHT, 1},
-        {FACE_IDX_TOP, 7, FACE_IDX_BACK, 1},
-
-        {FACE_IDX_BOTTOM, 1, FACE_IDX_BACK, 7},
-        {FACE_IDX_BOTTOM, 3, FACE_IDX_LEFT, 7},
-        {FACE_IDX_BOTTOM, 5, FACE_IDX_RIGHT, 7},
-        {FACE_IDX_BOTTOM, 7, FACE_IDX_FRONT, 7},
-
-        { FACE_IDX_FRONT, 3, FACE_IDX_LEFT, 3},
-        { FACE_IDX_FRONT, 5, FACE_IDX_RIGHT, 5},
-        { FACE_IDX_BACK, 5, FACE_IDX_LEFT, 5},
-        { FACE_IDX_BACK, 3, FACE_IDX_RIGHT, 3},
-    };
-
-    const int EDGE_COUNT = sizeof(edge_map) / sizeof(edge_map[0]);
-
-    for (int i = 0; i < EDGE_COUNT; ++i) {
-        FaceIndex f1 = edge_map[i].face1;
-        int p1 = edge_map[i].pos1;
-        FaceIndex f2 = edge_map[i].face2;
-        int p2 = edge_map[i].pos2;
+bool find_edge_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RGBColor color2,
+                     FaceIndex* face1, int* pos1, FaceIndex* face2, int* pos2) {
+    for (int i = 0; i < CUBIE_EDGE_COUNT; ++i) {
+        FaceIndex f1 = cubie_edge_facelets[i][0][0];
+        int p1 = cubie_edge_facelets[i][0][1];
+        FaceIndex f2 = cubie_edge_facelets[i][1][0];
+        int p2 = cubie_edge_facelets[i][1][1];
 
         RGBColor c1 = cubeColors[f1][p1];
         RGBColor c2 = cubeColors[f2][p2];
@@ -327,32 +417,16 @@ static bool find_edge_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RG
     return false;
 }
 
-static bool find_corner_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RGBColor color2, RGBColor color3,
-                              FaceIndex* face1, int* pos1, FaceIndex* face2, int* pos2, FaceIndex* face3, int* pos3) {
-    static const struct {
-        FaceIndex face1, pos1, face2, pos2, face3, pos3;
-    } corner_map[] = {
-        {FACE_IDX_TOP, 0, FACE_IDX_FRONT, 0, FACE_IDX_LEFT, 0},
-        {FACE_IDX_TOP, 2, FACE_IDX_RIGHT, 2, FACE_IDX_FRONT, 2},
-        {FACE_IDX_TOP, 6, FACE_IDX_LEFT, 2, FACE_IDX_BACK, 2},
-        {FACE_IDX_TOP, 8, FACE_IDX_BACK, 0, FACE_IDX_RIGHT, 0},
-
-        {FACE_IDX_BOTTOM, 0, FACE_IDX_BACK, 8, FACE_IDX_LEFT, 8},
-        {FACE_IDX_BOTTOM, 2, FACE_IDX_RIGHT, 6, FACE_IDX_BACK, 6},
-        {FACE_IDX_BOTTOM, 6, FACE_IDX_LEFT, 6, FACE_IDX_FRONT, 6},
-        {FACE_IDX_BOTTOM, 8, FACE_IDX_FRONT, 8, FACE_IDX_RIGHT, 8},
-    };
-
-    const int CORNER_COUNT = sizeof(corner_map) / sizeof(corner_map[0]);
-
-    for (int i = 0; i < CORNER_COUNT; ++i) {
-        FaceIndex f1 = corner_map[i].face1;
-        int p1 = corner_map[i].pos1;
-        FaceIndex f2 = corner_map[i].face2;
-        int p2 = corner_map[i].pos2;
-        FaceIndex f3 = corner_map[i].face3;
-        int p3 = corner_map[i].pos3;    
-        
+bool find_corner_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RGBColor color2, RGBColor color3,
+                       FaceIndex* face1, int* pos1, FaceIndex* face2, int* pos2, FaceIndex* face3, int* pos3) {
+    for (int i = 0; i < CUBIE_CORNER_COUNT; ++i) {
+        FaceIndex f1 = cubie_corner_facelets[i][0][0];
+        int p1 = cubie_corner_facelets[i][0][1];
+        FaceIndex f2 = cubie_corner_facelets[i][1][0];
+        int p2 = cubie_corner_facelets[i][1][1];
+        FaceIndex f3 = cubie_corner_facelets[i][2][0];
+        int p3 = cubie_corner_facelets[i][2][1];
+
         RGBColor c1 = cubeColors[f1][p1];
         RGBColor c2 = cubeColors[f2][p2];
         RGBColor c3 = cubeColors[f3][p3];
@@ -477,8 +551,8 @@ static void get_side_positions(const RGBColor (*cubeColors)[9], int (*positions_
     }
 }
 
-static void solve_white_cross(RGBColor (*cubeColors)[9], MoveSequence* solution) {
-    printf("Solving white cross...\n");
+static void solve_white_cross(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    solver_log(ctx, "Solving white cross...\n");
     
     RGBColor white = get_center_color(cubeColors, FACE_IDX_TOP);
     
@@ -524,7 +598,7 @@ static void solve_white_cross(RGBColor (*cubeColors)[9], MoveSequence* solution)
         Move return_move = -1;
 
         if (!find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos)) {
-            printf("No edge piece found\n");
+            solver_log(ctx, "No edge piece found\n");
             return;
         }
 
@@ -547,1027 +621,111 @@ static void solve_white_cross(RGBColor (*cubeColors)[9], MoveSequence* solution)
             // Если снизу, то 
             else if (white_pos == 7) {
                 // Чтобы не помешать другим граням, поворачиваем нижнюю грань на свое место
-                int white_pos_index = index_array(white_face, (int*)adjacent_faces);
-                int move_index = ((white_pos_index - i) + 4) % 4;
-                if (move_index != 0)
-                    move_sequence_add(solution, down_moves[move_index - 1], cubeColors);
-                find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos);
-                // И делаем поворот чтобы следующим ходом опустить его вниз
-                move_sequence_add(solution, get_move_from_face_and_direction(white_face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos);
-            }
-
-            // Если цвет на боковой грани, то
-            if ((color_pos == 5 || color_pos == 3) && color_face != adj_face) {
-                // В зависимости от положения цвета, поворачиваем грань по часовой или против часовой стрелки
-                RotationDirection direction = color_pos == 5 ? ROTATE_CLOCKWISE : ROTATE_COUNTERCLOCKWISE;
-                // Если цвет на левой или правой грани, то поворачиваем в противоположную сторону
-                if (color_face == FACE_IDX_LEFT || color_face == FACE_IDX_RIGHT) direction *= -1;
-                // Если сверху деталь на своем месте, то запоминаем, что надо будет вернуть его на место 
-                if (colors_equal(get_color(cubeColors, FACE_IDX_TOP, top_target_positions[index_array(color_face, (int*)adjacent_faces)]), white)) {
-                    return_move = get_move_from_face_and_direction(color_face, -direction);
-                }
-                move_sequence_add(solution, get_move_from_face_and_direction(color_face, direction), cubeColors);
-                find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos);
-            }
-
-            // Если цвет на своей грани, то поворачиваем ее на свое место
-            if (color_face == adj_face) {
-                RotationDirection direction = color_pos == 3 ? ROTATE_CLOCKWISE : ROTATE_COUNTERCLOCKWISE;
-                if (color_face == FACE_IDX_LEFT || color_face == FACE_IDX_RIGHT) {
-                    direction = -direction;
-                }
-                move_sequence_add(solution, get_move_from_face_and_direction(color_face, direction), cubeColors);
-                continue;
-            }
-        }
-
-        // Если белый цвет на нижней грани, то поворачиваем нижнюю грань на свое место и поднимаем деталь вверх
-        int white_pos_index = index_array(white_pos, bottom_target_positions);
-        int move_index = ((white_pos_index - i) + 4) % 4;
-        if (move_index != 0)
-            move_sequence_add(solution, down_moves[move_index - 1], cubeColors);
-
-        // Если надо вернуть деталь на место, то делаем это
-        if (return_move != -1) {
-            move_sequence_add(solution, return_move, cubeColors);
-        }
-
-        // Поворачиваем грань на 180 градусов, чтобы поставить деталь на свое место
-        move_sequence_add(solution, get_move_from_face_and_direction(adj_face, ROTATE_180), cubeColors);
-
-    }
-}
-
-static void solve_F2L(RGBColor (*cubeColors)[9], MoveSequence* solution) {
-    printf("Solving F2L...\n");
-
-    int bottom_target_positions[] = {1, 3, 7, 5};
-    Move down_moves[] = {MOVE_D_PRIME, MOVE_D2, MOVE_D};
-    FaceIndex adjacent_faces[] = {FACE_IDX_FRONT, FACE_IDX_RIGHT, FACE_IDX_BACK, FACE_IDX_LEFT};
-
-    RGBColor white = get_center_color(cubeColors, FACE_IDX_TOP);
-
-    // Проверяем, если все угловые детали на своем месте
-    for (int i = 0; i < 4; i++) {
-        FaceIndex face = FACE_IDX_FRONT + i;
-        int pos = 1;
-        FaceIndex face2 = (face + 1) % 5 + 1;
-        int pos2 = 1;
-
-        RGBColor color1 = get_center_color(cubeColors, face);
-        RGBColor color2 = get_center_color(cubeColors, face2);
-
-        FaceIndex color_face, color_face2;
-        int color_pos, color_pos2;
-
-        find_edge_piece(cubeColors, color1, color2, &color_face, &color_pos, &color_face2, &color_pos2);
-
-        if (!(color_face == face && color_face2 == face2)) {
-            break;
-        }
-
-        FaceIndex white_face;
-        int white_pos;
-
-        find_corner_piece(cubeColors, color1, color2, white, &color_face, &color_pos, &color_face2, &color_pos2, &white_face, &white_pos);
-
-        if (!(color_face == face && color_face2 == face2 && white_face == FACE_IDX_TOP)) {
-            break;
-        }        
-    }
-    
-    for (int i = 0; i < 4; i++) {
-        FaceIndex face = FACE_IDX_FRONT + i;
-        int pos = 1;
-        FaceIndex face2 = (face % 4) + 1;
-        int pos2 = 1;
-        FaceIndex face3 = (face2 % 4) + 1;
-        FaceIndex face4 = (face3 % 4) + 1;
-
-        RGBColor color1 = get_center_color(cubeColors, face);
-        RGBColor color2 = get_center_color(cubeColors, face2);
-
-        FaceIndex edge_color_face, edge_color_face2;
-        int edge_color_pos, edge_color_pos2;
-
-        find_edge_piece(cubeColors, color1, color2, &edge_color_face, &edge_color_pos, &edge_color_face2, &edge_color_pos2);
-
-        FaceIndex corner_color_face, corner_color_face2, corner_white_face;
-        int corner_color_pos, corner_color_pos2, corner_white_pos;
-
-        find_corner_piece(cubeColors, color1, color2, white, &corner_color_face, &corner_color_pos, &corner_color_face2, &corner_color_pos2, &corner_white_face, &corner_white_pos);
-        
-        
-        // stuck cases
-        if((!(corner_color_face == face && corner_color_face2 == face2 || corner_color_face2 == face && corner_white_face == face2 || corner_color_face == face2 && corner_white_face == face) && 
-            (corner_white_face == FACE_IDX_TOP || corner_color_face == FACE_IDX_TOP || corner_color_face2 == FACE_IDX_TOP)))    
-        {   
-            FaceIndex face_before = (corner_white_face == 1) ? 4 : corner_white_face - 1;
-            FaceIndex face_before1 = (corner_color_face == 1) ? 4 : corner_color_face - 1;
-            FaceIndex face_before2 = (corner_color_face2 == 1) ? 4 : corner_color_face2 - 1;
-
-            RotationDirection rotation = ROTATE_CLOCKWISE;
-
-            FaceIndex corner_white_face_to_rotate = corner_white_face;
-
-            if (corner_white_face == FACE_IDX_TOP) {
-                corner_white_face_to_rotate = corner_color_face;
-                if (edge_color_face == face_before1 || edge_color_face2 == face_before1) {
-                    rotation *= -1;
-                }
-            } else if (corner_color_face == FACE_IDX_TOP) {
-                corner_white_face_to_rotate = corner_color_face2;
-                if (edge_color_face == face_before2 || edge_color_face2 == face_before2) {
-                    rotation *= -1;
-                }
-            } else if (corner_color_face2 == FACE_IDX_TOP) {
-                corner_white_face_to_rotate = corner_white_face;
-                if (edge_color_face == face_before || edge_color_face2 == face_before) {
-                    rotation *= -1;
-                }
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(corner_white_face_to_rotate, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, rotation), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(corner_white_face_to_rotate, ROTATE_COUNTERCLOCKWISE), cubeColors);
-
-            find_corner_piece(cubeColors, color1, color2, white, &corner_color_face, &corner_color_pos, &corner_color_face2, &corner_color_pos2, &corner_white_face, &corner_white_pos);
-            find_edge_piece(cubeColors, color1, color2, &edge_color_face, &edge_color_pos, &edge_color_face2, &edge_color_pos2);
-        } 
-        if ( 
-            !((edge_color_face == face && edge_color_face2 == face2) || (edge_color_face == face2 && edge_color_face2 == face)) && 
-            !(edge_color_face == FACE_IDX_BOTTOM || edge_color_face2 == FACE_IDX_BOTTOM))
-        {
-            RotationDirection rotation = ROTATE_CLOCKWISE;
-            FaceIndex edge_color_face_to_rotate = edge_color_face;
-            if (edge_color_face == FACE_IDX_FRONT || edge_color_face == FACE_IDX_BACK) {
-                if (edge_color_pos == 5) rotation = ROTATE_CLOCKWISE;
-                else rotation = ROTATE_COUNTERCLOCKWISE;
-            } else if (edge_color_face == FACE_IDX_LEFT || edge_color_face == FACE_IDX_RIGHT) {
-                if (edge_color_pos == 5) rotation = ROTATE_COUNTERCLOCKWISE;
-                else rotation = ROTATE_CLOCKWISE;
-            }
-            for (int i = 0; i < 2; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(edge_color_face_to_rotate, rotation), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(edge_color_face_to_rotate, -rotation), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-            find_corner_piece(cubeColors, color1, color2, white, &corner_color_face, &corner_color_pos, &corner_color_face2, &corner_color_pos2, &corner_white_face, &corner_white_pos);
-            find_edge_piece(cubeColors, color1, color2, &edge_color_face, &edge_color_pos, &edge_color_face2, &edge_color_pos2);
-        } 
-
-        // printf("face1: %d, face2: %d\n", face, face2);
-
-
-        FaceIndex face_after_corner_white_face = (corner_white_face == 4) ? 1 : corner_white_face + 1;
-
-        FaceIndex face_before_corner_white_face = (corner_white_face == 1) ? 4 : corner_white_face - 1;
-
-        FaceIndex face_on_the_other_side_of_white = (corner_white_face + 1) % 4 + 1;
-
-        FaceIndex face_on_the_other_side_of_color = (corner_color_face + 1) % 4 + 1;
-        FaceIndex face_on_the_other_side_of_color2 = (corner_color_face2 + 1) % 4 + 1;
-        
-        // Basic Inserts
-
-        // F2L 1,2
-        if (edge_color_face == corner_color_face && edge_color_face2 == corner_color_face2 && corner_white_face != FACE_IDX_BOTTOM) {
-            int white_pos_index = index_array(corner_white_face, (int*)adjacent_faces);
-            if (edge_color_face == FACE_IDX_BOTTOM) {
-                printf("F2L 1\n");
-                RotationDirection direction = ROTATE_CLOCKWISE;
-                if (corner_white_face == face) {
-                    move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                } else if (corner_white_face == face2) {
-                    move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-                } else if (corner_white_face == face3) {
-                    direction = ROTATE_180;
-                }
-
-                move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, direction), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            }
-            else 
-            // F2L 2 work
-            if (edge_color_face2 == FACE_IDX_BOTTOM) {
-                printf("F2L 2\n");
-                RotationDirection direction = ROTATE_COUNTERCLOCKWISE;
-                if (corner_white_face == face) {
-                    move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-                } else if (corner_white_face == face2) {
-                    move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-                } else if (corner_white_face == face4) {
-                    direction = ROTATE_180;
-                }
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, direction), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-        }
-        
-        // F2L 3 work
-        else if (edge_color_face2 == face_after_corner_white_face && edge_color_face == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 3\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-        // F2L 4 work
-        else if (edge_color_face == face_before_corner_white_face && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 4\n");
-            if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // Reposition Edge
-        
-        // F2L 5 work
-        else if (edge_color_face == face_on_the_other_side_of_white && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 5\n");
-            if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // F2L 6 work?
-        else if (edge_color_face2 == face_on_the_other_side_of_white && edge_color_face == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 6\n");
-            if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-
-        }
-    
-        // F2L 7 work
-        else if (edge_color_face == face_after_corner_white_face && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 7\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            for (int i = 0; i < 2; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }  
-        }
-    
-        // F2L 8
-        else if (edge_color_face2 == face_before_corner_white_face && edge_color_face == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 8\n");
-            if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            for (int i = 0; i < 2; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // Reposition Edge and Flip Corner
-
-        // F2L 9
-        else if (edge_color_face2 == face_on_the_other_side_of_white && edge_color_face == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 9\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);            
-        }
-    
-        // F2L 10 work
-        else if (edge_color_face == face_on_the_other_side_of_white && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 10\n");
-            if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            // move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // F2L 11 work
-        else if (edge_color_face2 == face_before_corner_white_face && edge_color_face == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 11\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);          
-        }
-    
-        // F2L 12 work
-        else if (edge_color_face == face_after_corner_white_face && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 12\n");
-            if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-            //R' U2 R2 U R2 U R
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-        }
-
-        // F2L 13 work
-        else if (edge_color_face2 == corner_white_face && edge_color_face == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 13\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // F2L 14 work
-        else if (edge_color_face == corner_white_face && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 14\n");
-            if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // Split Pair by Going Over
-
-        // F2L 15 work
-        else if (edge_color_face == corner_white_face && edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 15\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // F2L 16 work
-        else if (edge_color_face2 == corner_white_face && edge_color_face == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 16\n");
-            if (corner_white_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-    
-        // F2L 17 work
-        else if (edge_color_face == corner_color_face2 && edge_color_face2 == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 17\n");
-            if (corner_color_face2 == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_color_face2 == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face2 == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 18 work
-        else if (edge_color_face2 == corner_color_face && edge_color_face == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 18\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-            for (int i = 0; i < 2; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-        }
-    
-        
-        // Pair Made on Side
-
-        // F2L 19 work
-        else if (edge_color_face == face_on_the_other_side_of_color && edge_color_face2 == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 19\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            for (int i = 0; i < 2; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);   
-        }
-    
-        // F2L 20
-        else if (edge_color_face2 == face_on_the_other_side_of_color2 && edge_color_face == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 20\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);          
-        }
-    
-        // F2L 21 work
-        else if (edge_color_face == face_on_the_other_side_of_color2 && edge_color_face2 == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 21\n");
-
-            if (corner_color_face2 == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (corner_color_face2 == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face2 == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-    
-        // F2L 22 work
-        else if (edge_color_face2 == face_on_the_other_side_of_color && edge_color_face == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 22\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-    
-
-        // Weird
-
-        // F2L 23 work
-        else if (edge_color_face == corner_color_face && edge_color_face2 == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 23\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 24 work
-        else if (edge_color_face2 == corner_color_face2 && edge_color_face == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 24\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 25
-        else if (edge_color_face2 == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_TOP && corner_color_face == face) {
-            printf("F2L 25\n");
-            if (edge_color_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (edge_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (edge_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 26 work
-        else if (edge_color_face == FACE_IDX_BOTTOM && corner_white_face == FACE_IDX_TOP && corner_color_face == face) {
-            printf("F2L 26\n");
-            if (edge_color_face2 == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (edge_color_face2 == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (edge_color_face2 == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-            
-        // F2L 27 work
-        else if (edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_TOP) {
-            printf("F2L 27\n");
-            if (edge_color_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (edge_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (edge_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 28 work
-        else if (edge_color_face == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_TOP) {
-            printf("F2L 28\n");
-            if (edge_color_face2 == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (edge_color_face2 == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (edge_color_face2 == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-
-        // F2L 29
-        else if (edge_color_face == FACE_IDX_BOTTOM && corner_color_face == FACE_IDX_TOP) {
-            printf("F2L 29\n");
-            if (edge_color_face2 == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (edge_color_face2 == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (edge_color_face2 == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            for (int i = 0; i < 2; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-        }
-
-        // F2L 30 work
-        else if (edge_color_face2 == FACE_IDX_BOTTOM && corner_color_face2 == FACE_IDX_TOP) {
-            printf("F2L 30\n");
-            if (edge_color_face == face2) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            } else if (edge_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (edge_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // Edge in Place, Corner in D face
-
-        // F2L 31 work
-        else if (edge_color_face == face2 && edge_color_face2 == face && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 31\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-
-        // F2L 32 work
-        else if (edge_color_face == face && edge_color_face2 == face2 && corner_white_face == FACE_IDX_BOTTOM) {
-            printf("F2L 32\n");
-            if (corner_color_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            for (int i = 0; i < 3; i++) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-                move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-        }
-
-        // F2L 33 work
-        else if (edge_color_face == face && edge_color_face2 == face2 && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 33\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 34 work
-        else if (edge_color_face == face && edge_color_face2 == face2 && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 34\n");
-            if (corner_color_face2 == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_color_face2 == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_color_face2 == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            }
-
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-
-        // F2L 35 work
-        else if (edge_color_face == face2 && edge_color_face2 == face && corner_color_face2 == FACE_IDX_BOTTOM) {
-            printf("F2L 35\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
+                int white_pos_index = index_array(white_face, (int*)adjacent_faces);
+                int move_index = ((white_pos_index - i) + 4) % 4;
+                if (move_index != 0)
+                    move_sequence_add(solution, down_moves[move_index - 1], cubeColors);
+                find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos);
+                // И делаем поворот чтобы следующим ходом опустить его вниз
+                move_sequence_add(solution, get_move_from_face_and_direction(white_face, ROTATE_COUNTERCLOCKWISE), cubeColors);
+                find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos);
             }
 
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-        }
-
-        // F2L 36 work
-        else if (edge_color_face == face2 && edge_color_face2 == face && corner_color_face == FACE_IDX_BOTTOM) {
-            printf("F2L 36\n");
-            if (corner_white_face == face) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            } else if (corner_white_face == face4) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            } else if (corner_white_face == face3) {
-                move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
+            // Если цвет на боковой грани, то
+            if ((color_pos == 5 || color_pos == 3) && color_face != adj_face) {
+                // В зависимости от положения цвета, поворачиваем грань по часовой или против часовой стрелки
+                RotationDirection direction = color_pos == 5 ? ROTATE_CLOCKWISE : ROTATE_COUNTERCLOCKWISE;
+                // Если цвет на левой или правой грани, то поворачиваем в противоположную сторону
+                if (color_face == FACE_IDX_LEFT || color_face == FACE_IDX_RIGHT) direction *= -1;
+                // Если сверху деталь на своем месте, то запоминаем, что надо будет вернуть его на место 
+                if (colors_equal(get_color(cubeColors, FACE_IDX_TOP, top_target_positions[index_array(color_face, (int*)adjacent_faces)]), white)) {
+                    return_move = get_move_from_face_and_direction(color_face, -direction);
+                }
+                move_sequence_add(solution, get_move_from_face_and_direction(color_face, direction), cubeColors);
+                find_edge_piece(cubeColors, white, target_color, &white_face, &white_pos, &color_face, &color_pos);
             }
 
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
+            // Если цвет на своей грани, то поворачиваем ее на свое место
+            if (color_face == adj_face) {
+                RotationDirection direction = color_pos == 3 ? ROTATE_CLOCKWISE : ROTATE_COUNTERCLOCKWISE;
+                if (color_face == FACE_IDX_LEFT || color_face == FACE_IDX_RIGHT) {
+                    direction = -direction;
+                }
+                move_sequence_add(solution, get_move_from_face_and_direction(color_face, direction), cubeColors);
+                continue;
+            }
         }
 
-        // Edge and Corner in Place
-        
-        // F2L 37
-        // solved state
-
-        // F2L 38 work
-        else if (edge_color_face == face2 && edge_color_face2 == face && corner_white_face == FACE_IDX_TOP && corner_color_face2 == face2) {
-            printf("F2L 38\n");
+        // Если белый цвет на нижней грани, то поворачиваем нижнюю грань на свое место и поднимаем деталь вверх
+        int white_pos_index = index_array(white_pos, bottom_target_positions);
+        int move_index = ((white_pos_index - i) + 4) % 4;
+        if (move_index != 0)
+            move_sequence_add(solution, down_moves[move_index - 1], cubeColors);
 
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
+        // Если надо вернуть деталь на место, то делаем это
+        if (return_move != -1) {
+            move_sequence_add(solution, return_move, cubeColors);
         }
 
-        // F2L 39
-        else if (edge_color_face == face && edge_color_face2 == face2 && corner_color_face == FACE_IDX_TOP && corner_color_face2 == face) {
-            printf("F2L 39\n");
+        // Поворачиваем грань на 180 градусов, чтобы поставить деталь на свое место
+        move_sequence_add(solution, get_move_from_face_and_direction(adj_face, ROTATE_180), cubeColors);
 
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
+    }
+}
 
-        // F2L 40
-        else if (edge_color_face == face && edge_color_face2 == face2 && corner_color_face2 == FACE_IDX_TOP && corner_color_face == face2) {
-            printf("F2L 40\n");
+static void solve_xcross(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    solver_log(ctx, "Solving XCross...\n");
 
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
-        }
+    CubieCube cube;
+    Move moves[XCROSS_MAX_DEPTH];
+    int count = -1;
+    if (cubie_cube_from_colors(&cube, cubeColors)) {
+        count = xcross_solve(&cube, ctx->options.move_cost, moves, XCROSS_MAX_DEPTH);
+    }
+
+    if (count < 0) {
+        solver_log(ctx, "XCross not found, falling back to cross\n");
+        solve_white_cross(ctx, cubeColors, solution);
+        return;
+    }
 
-        // F2L 41
-        else if (edge_color_face == face2 && edge_color_face2 == face && corner_color_face == FACE_IDX_TOP && corner_color_face2 == face) {
-            printf("F2L 41\n");
+    solver_log(ctx, "XCross: %d moves\n", count);
+    for (int i = 0; i < count; i++) {
+        move_sequence_add(solution, moves[i], cubeColors);
+    }
+}
 
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
+static void solve_F2L(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    solver_log(ctx, "Solving F2L...\n");
 
-        // F2L 42 work
-        else if (edge_color_face == face2 && edge_color_face2 == face && corner_color_face2 == FACE_IDX_TOP && corner_color_face == face2) {
-            printf("F2L 42\n");
+    CubieCube cube;
+    if (!cubie_cube_from_colors(&cube, cubeColors)) {
+        solver_log(ctx, "F2L: unknown piece colours\n");
+        return;
+    }
 
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
-            move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
-        }
-        
-    }   
+    // Без multislot каждый шаг ставим самую дешёвую пару, иначе сравниваем порядки слотов
+    int beam_width = ctx->options.multislot ? F2L_BEAM_WIDTH : 1;
+    Move moves[F2L_MAX_TOTAL];
+    int count = f2l_plan(&cube, beam_width, ctx->options.move_cost, &ctx->arena, moves, F2L_MAX_TOTAL);
+    if (count < 0) {
+        solver_log(ctx, "F2L: position unknown\n");
+        return;
+    }
 
+    solver_log(ctx, "F2L: %d moves\n", count);
+    for (int i = 0; i < count; i++) {
+        move_sequence_add(solution, moves[i], cubeColors);
+    }
 }
 
-static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
-    printf("Solving OLL...\n");
+static void solve_OLL(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    solver_log(ctx, "Solving OLL...\n");
     int positions_bottom[9];
     int positions_sides[4][3];
 
-    RGBColor (*temp_cubeColors)[9] = malloc(sizeof(RGBColor[6][9]));
+    RGBColor (*temp_cubeColors)[9] = solver_arena_alloc(&ctx->arena, sizeof(RGBColor[6][9]));
+    if (!temp_cubeColors) return;
     copy_cube_state(cubeColors, temp_cubeColors);
 
     rotate_face_colors(temp_cubeColors, FACE_IDX_BOTTOM, ROTATE_CLOCKWISE);
@@ -1584,7 +742,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
     for (int i = 0; i < 4; i++) {
         if (bottom_equal(positions_bottom, b_OLL_1) && sides_equal(positions_sides, s_OLL_1)) {
-            printf("OLL 1\n");
+            solver_log(ctx, "OLL 1\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -1600,7 +758,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_2) && sides_equal(positions_sides, s_OLL_2)) {
-            printf("OLL 2\n");
+            solver_log(ctx, "OLL 2\n");
 
             // F R U R' U' F' U2 F U R U' R' F'
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -1619,7 +777,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_3) && sides_equal(positions_sides, s_OLL_3)) {
-            printf("OLL 3\n");
+            solver_log(ctx, "OLL 3\n");
 
             // U F U2 F R' F' R U R U R' U F'
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -1638,7 +796,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_4) && sides_equal(positions_sides, s_OLL_4)) {
-            printf("OLL 4\n");
+            solver_log(ctx, "OLL 4\n");
 
             // R' U' F' U' F R U' R' F' U' F U' R
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1657,7 +815,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_5) && sides_equal(positions_sides, s_OLL_5)) {
-            printf("OLL 5\n");
+            solver_log(ctx, "OLL 5\n");
 
             // F R U R' U' F' U' F R U R' U' F'
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -1676,7 +834,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_6) && sides_equal(positions_sides, s_OLL_6)) {
-            printf("OLL 6\n");
+            solver_log(ctx, "OLL 6\n");
 
             // U2 F' U' F2 R' F' R U R U2 R' (U2 не было)
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -1693,7 +851,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_7) && sides_equal(positions_sides, s_OLL_7)) {
-            printf("OLL 7\n");
+            solver_log(ctx, "OLL 7\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1706,7 +864,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_8) && sides_equal(positions_sides, s_OLL_8)) {
-            printf("OLL 8\n");
+            solver_log(ctx, "OLL 8\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -1719,7 +877,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_9) && sides_equal(positions_sides, s_OLL_9)) {
-            printf("OLL 9\n");
+            solver_log(ctx, "OLL 9\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1736,7 +894,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_10) && sides_equal(positions_sides, s_OLL_10)) {
-            printf("OLL 10\n");
+            solver_log(ctx, "OLL 10\n");
 
             // U' R U R' U R' F R F' R U2 R'
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1754,7 +912,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_11) && sides_equal(positions_sides, s_OLL_11)) {
-            printf("OLL 11\n");
+            solver_log(ctx, "OLL 11\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1774,7 +932,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_12) && sides_equal(positions_sides, s_OLL_12)) {
-            printf("OLL 12\n");
+            solver_log(ctx, "OLL 12\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -1792,7 +950,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_13) && sides_equal(positions_sides, s_OLL_13)) {
-            printf("OLL 13\n");
+            solver_log(ctx, "OLL 13\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -1807,7 +965,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_14) && sides_equal(positions_sides, s_OLL_14)) {
-            printf("OLL 14\n");
+            solver_log(ctx, "OLL 14\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -1822,7 +980,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_15) && sides_equal(positions_sides, s_OLL_15)) {
-            printf("OLL 15\n");
+            solver_log(ctx, "OLL 15\n");
 
             // U2 F R U R' U' F' U R U R' U R U2 R'
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -1843,7 +1001,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_16) && sides_equal(positions_sides, s_OLL_16)) {
-            printf("OLL 16\n");
+            solver_log(ctx, "OLL 16\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -1861,7 +1019,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_17) && sides_equal(positions_sides, s_OLL_17)) {
-            printf("OLL 17\n");
+            solver_log(ctx, "OLL 17\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -1879,7 +1037,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_18) && sides_equal(positions_sides, s_OLL_18)) {
-            printf("OLL 18\n");
+            solver_log(ctx, "OLL 18\n");
 
             // U' F R' F' R U R U' R' U F R U R' U' F'
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1901,7 +1059,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_19) && sides_equal(positions_sides, s_OLL_19)) {
-            printf("OLL 19\n");
+            solver_log(ctx, "OLL 19\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -1921,7 +1079,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_20) && sides_equal(positions_sides, s_OLL_20)) {
-            printf("OLL 20\n");
+            solver_log(ctx, "OLL 20\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_CLOCKWISE), cubeColors);
@@ -1938,7 +1096,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_21) && sides_equal(positions_sides, s_OLL_21)) {
-            printf("OLL 21\n");
+            solver_log(ctx, "OLL 21\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -1954,7 +1112,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_22) && sides_equal(positions_sides, s_OLL_22)) {
-            printf("OLL 22\n");
+            solver_log(ctx, "OLL 22\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -1968,7 +1126,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_23) && sides_equal(positions_sides, s_OLL_23)) {
-            printf("OLL 23\n");
+            solver_log(ctx, "OLL 23\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_TOP, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -1982,7 +1140,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_24) && sides_equal(positions_sides, s_OLL_24)) {
-            printf("OLL 24\n");
+            solver_log(ctx, "OLL 24\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -1995,7 +1153,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_25) && sides_equal(positions_sides, s_OLL_25)) {
-            printf("OLL 25\n");
+            solver_log(ctx, "OLL 25\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2008,7 +1166,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_26) && sides_equal(positions_sides, s_OLL_26)) {
-            printf("OLL 26\n");
+            solver_log(ctx, "OLL 26\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2020,7 +1178,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_27) && sides_equal(positions_sides, s_OLL_27)) {
-            printf("OLL 27\n");
+            solver_log(ctx, "OLL 27\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2032,7 +1190,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_28) && sides_equal(positions_sides, s_OLL_28)) {
-            printf("OLL 28\n");
+            solver_log(ctx, "OLL 28\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -2048,7 +1206,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_29) && sides_equal(positions_sides, s_OLL_29)) {
-            printf("OLL 29\n");
+            solver_log(ctx, "OLL 29\n");
 
             // U R U R' U' R U' R' F' U' F R U R'
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2068,7 +1226,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_30) && sides_equal(positions_sides, s_OLL_30)) {
-            printf("OLL 30\n");
+            solver_log(ctx, "OLL 30\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_180), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2084,7 +1242,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_31) && sides_equal(positions_sides, s_OLL_31)) {
-            printf("OLL 31\n");
+            solver_log(ctx, "OLL 31\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2098,7 +1256,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_32) && sides_equal(positions_sides, s_OLL_32)) {
-            printf("OLL 32\n");
+            solver_log(ctx, "OLL 32\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2112,7 +1270,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_33) && sides_equal(positions_sides, s_OLL_33)) {
-            printf("OLL 33\n");
+            solver_log(ctx, "OLL 33\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2125,7 +1283,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_34) && sides_equal(positions_sides, s_OLL_34)) {
-            printf("OLL 34\n");
+            solver_log(ctx, "OLL 34\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2141,7 +1299,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_35) && sides_equal(positions_sides, s_OLL_35)) {
-            printf("OLL 35\n");
+            solver_log(ctx, "OLL 35\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -2155,7 +1313,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_36) && sides_equal(positions_sides, s_OLL_36)) {
-            printf("OLL 36\n");
+            solver_log(ctx, "OLL 36\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2172,7 +1330,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_37) && sides_equal(positions_sides, s_OLL_37)) {
-            printf("OLL 37\n");
+            solver_log(ctx, "OLL 37\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2185,7 +1343,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_38) && sides_equal(positions_sides, s_OLL_38)) {
-            printf("OLL 38\n");
+            solver_log(ctx, "OLL 38\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2202,7 +1360,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_39) && sides_equal(positions_sides, s_OLL_39)) {
-            printf("OLL 39\n");
+            solver_log(ctx, "OLL 39\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2216,7 +1374,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_40) && sides_equal(positions_sides, s_OLL_40)) {
-            printf("OLL 40\n");
+            solver_log(ctx, "OLL 40\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -2230,7 +1388,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_41) && sides_equal(positions_sides, s_OLL_41)) {
-            printf("OLL 41\n");
+            solver_log(ctx, "OLL 41\n");
 
             // R U' R' U2 R U B U' B' U' R'
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -2247,7 +1405,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }   
         else if (bottom_equal(positions_bottom, b_OLL_42) && sides_equal(positions_sides, s_OLL_42)) {
-            printf("OLL 42\n");
+            solver_log(ctx, "OLL 42\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2265,7 +1423,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_43) && sides_equal(positions_sides, s_OLL_43)) {
-            printf("OLL 43\n");
+            solver_log(ctx, "OLL 43\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2276,7 +1434,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_44) && sides_equal(positions_sides, s_OLL_44)) {
-            printf("OLL 44\n");
+            solver_log(ctx, "OLL 44\n");
 
             // B U L U' L' B'
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_CLOCKWISE), cubeColors);
@@ -2288,7 +1446,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_45) && sides_equal(positions_sides, s_OLL_45)) {
-            printf("OLL 45\n");
+            solver_log(ctx, "OLL 45\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -2299,7 +1457,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_46) && sides_equal(positions_sides, s_OLL_46)) {
-            printf("OLL 46\n");
+            solver_log(ctx, "OLL 46\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2312,7 +1470,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_47) && sides_equal(positions_sides, s_OLL_47)) {
-            printf("OLL 47\n");
+            solver_log(ctx, "OLL 47\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2327,7 +1485,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_48) && sides_equal(positions_sides, s_OLL_48)) {
-            printf("OLL 48\n");
+            solver_log(ctx, "OLL 48\n");
 
             // F R U R' U' R U R' U' F'
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -2343,7 +1501,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_49) && sides_equal(positions_sides, s_OLL_49)) {
-            printf("OLL 49\n");
+            solver_log(ctx, "OLL 49\n");
 
             // R B' R2 F R2 B R2 F' R
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -2358,7 +1516,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }   
         else if (bottom_equal(positions_bottom, b_OLL_50) && sides_equal(positions_sides, s_OLL_50)) {
-            printf("OLL 50\n");
+            solver_log(ctx, "OLL 50\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2373,7 +1531,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         }
         else if (bottom_equal(positions_bottom, b_OLL_51) && sides_equal(positions_sides, s_OLL_51)) {
-            printf("OLL 51\n");
+            solver_log(ctx, "OLL 51\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2388,7 +1546,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         } 
         else if (bottom_equal(positions_bottom, b_OLL_52) && sides_equal(positions_sides, s_OLL_52)) {
-            printf("OLL 52\n");
+            solver_log(ctx, "OLL 52\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2403,7 +1561,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         } 
         else if (bottom_equal(positions_bottom, b_OLL_53) && sides_equal(positions_sides, s_OLL_53)) {
-            printf("OLL 53\n");
+            solver_log(ctx, "OLL 53\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -2422,7 +1580,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         } 
         else if (bottom_equal(positions_bottom, b_OLL_54) && sides_equal(positions_sides, s_OLL_54)) {
-            printf("OLL 54\n");
+            solver_log(ctx, "OLL 54\n");
 
             // F' L' U' L U F L' U' L U L F' L' F
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2442,7 +1600,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         } 
         else if (bottom_equal(positions_bottom, b_OLL_55) && sides_equal(positions_sides, s_OLL_55)) {
-            printf("OLL 55\n");
+            solver_log(ctx, "OLL 55\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_180), cubeColors);
@@ -2458,7 +1616,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         } 
         else if (bottom_equal(positions_bottom, b_OLL_56) && sides_equal(positions_sides, s_OLL_56)) {
-            printf("OLL 56\n");
+            solver_log(ctx, "OLL 56\n");
 
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -2477,7 +1635,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             break;
         } 
         else if (bottom_equal(positions_bottom, b_OLL_57) && sides_equal(positions_sides, s_OLL_57)) {
-            printf("OLL 57\n");
+            solver_log(ctx, "OLL 57\n");
 
             // L' R U R' U' L R' F R F'
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2492,7 +1650,7 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
             break;
         } else {
-            printf("Position unknown\n");
+            solver_log(ctx, "Position unknown\n");
         }
 
         face = (face % 4) + 1;
@@ -2503,14 +1661,13 @@ static void solve_OLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
         rotate_face_colors(temp_cubeColors, FACE_IDX_BOTTOM, ROTATE_CLOCKWISE);
         get_yellow_positions(temp_cubeColors, positions_bottom, positions_sides);
     }
-    free(temp_cubeColors);
 }
 
-static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
-    printf("Solve PLL\n");
+static void solve_PLL(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    solver_log(ctx, "Solve PLL\n");
 
     if (is_cube_solved(cubeColors)) {
-        printf("Cube is already solved!\n");
+        solver_log(ctx, "Cube is already solved!\n");
         return;
     }
 
@@ -2532,10 +1689,10 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
     for (int i = 0; i < 4; i++) {
 
-        // printf("positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id1, positions_sides[id1][0], id1, positions_sides[id1][1], id1, positions_sides[id1][2]);
-        // printf("positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id2, positions_sides[id2][0], id2, positions_sides[id2][1], id2, positions_sides[id2][2]);
-        // printf("positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id3, positions_sides[id3][0], id3, positions_sides[id3][1], id3, positions_sides[id3][2]);
-        // printf("positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id4, positions_sides[id4][0], id4, positions_sides[id4][1], id4, positions_sides[id4][2]);
+        // solver_log(ctx, "positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id1, positions_sides[id1][0], id1, positions_sides[id1][1], id1, positions_sides[id1][2]);
+        // solver_log(ctx, "positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id2, positions_sides[id2][0], id2, positions_sides[id2][1], id2, positions_sides[id2][2]);
+        // solver_log(ctx, "positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id3, positions_sides[id3][0], id3, positions_sides[id3][1], id3, positions_sides[id3][2]);
+        // solver_log(ctx, "positions_sides[%d][0]: %d, positions_sides[%d][1]: %d, positions_sides[%d][2]: %d\n", id4, positions_sides[id4][0], id4, positions_sides[id4][1], id4, positions_sides[id4][2]);
 
         // If all the corners are in place
         if (
@@ -2544,7 +1701,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id3][0] == 3 && positions_sides[id3][2] == 3 && 
             positions_sides[id4][0] == 4 && positions_sides[id4][2] == 4
         ) {
-            printf("All corners are in place\n");
+            solver_log(ctx, "All corners are in place\n");
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
                 get_side_positions(cubeColors, positions_sides);
@@ -2555,7 +1712,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
             // H Permutation
             if (positions_sides[0][1] == 3 && positions_sides[1][1] == 4 && positions_sides[2][1] == 1 && positions_sides[3][1] == 2) {
-                printf("H Permutation\n");
+                solver_log(ctx, "H Permutation\n");
 
                 move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_CLOCKWISE), cubeColors);
                 move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
@@ -2576,7 +1733,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
                 f = true;
             }
             if ((positions_sides[0][1] == 4 && positions_sides[3][1] == 1 && positions_sides[1][1] == 3 && positions_sides[2][1] == 2) || f) {
-                printf("Z Permutation\n");
+                solver_log(ctx, "Z Permutation\n");
 
                 move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_CLOCKWISE), cubeColors);
                 move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2613,7 +1770,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
                     // U Permutation : b
                     if (positions_sides[prev_id][1] == next_color) {
-                        printf("U Permutation: b\n");
+                        solver_log(ctx, "U Permutation: b\n");
 
                         move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
                         move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2627,7 +1784,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
                         move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
                         move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_180), cubeColors);
                     } else {
-                        printf("U Permutation: a\n");
+                        solver_log(ctx, "U Permutation: a\n");
 
                         move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_180), cubeColors);
                         move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2658,7 +1815,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id4][1] == 4
         ) 
         {
-            printf("All edges are in place\n");
+            solver_log(ctx, "All edges are in place\n");
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
                 get_side_positions(cubeColors, positions_sides);
@@ -2675,7 +1832,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
                 // Find the corner with all the same color
                 if (positions_sides[j][1] == positions_sides[j][2] && positions_sides[j_next][0] == positions_sides[j_next][1]) {
                     if (positions_sides[j][0] != positions_sides[j_prev][1]) {
-                        printf("Aa Permutation\n");
+                        solver_log(ctx, "Aa Permutation\n");
 
                         move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
                         move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_CLOCKWISE), cubeColors);
@@ -2688,7 +1845,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
                         move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_180), cubeColors);
                         
                     } else {
-                        printf("Ab Permutation\n");
+                        solver_log(ctx, "Ab Permutation\n");
 
                         move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
                         move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2705,7 +1862,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
                 
                 // E Permutation
                 if (positions_sides[j][1] == positions_sides[j_next][0] && positions_sides[j][1] == positions_sides[j_prev][2]) {
-                    printf("E Permutation\n");
+                    solver_log(ctx, "E Permutation\n");
                     
                     move_sequence_add(solution, get_move_from_face_and_direction(face2, ROTATE_180), cubeColors);
                     move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2741,7 +1898,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id1][0] == positions_sides[id1][1] && 
             positions_sides[id1][2] == positions_sides[id1][1]
         ) {
-            printf("One side has all the same color\n");
+            solver_log(ctx, "One side has all the same color\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -2753,7 +1910,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
             // F Permutation
             if (positions_sides[2][1] == positions_sides[1][2] && positions_sides[2][1] == positions_sides[3][0]) {
-                printf("F Permutation\n");
+                solver_log(ctx, "F Permutation\n");
 
                 move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_COUNTERCLOCKWISE), cubeColors);
                 move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2773,7 +1930,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             }
             // J Permutation: a
             else if (positions_sides[2][1] == positions_sides[2][2] && positions_sides[3][0] == positions_sides[1][2]) {
-                printf("J Permutation: a\n");
+                solver_log(ctx, "J Permutation: a\n");
 
                 move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
                 move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_COUNTERCLOCKWISE), cubeColors);
@@ -2789,7 +1946,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             }
             // J Permutation: b
             else if (positions_sides[2][1] == positions_sides[2][0] && positions_sides[1][2] == positions_sides[3][0]) {
-                printf("J Permutation: b\n");
+                solver_log(ctx, "J Permutation: b\n");
 
                 move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
                 move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
@@ -2807,7 +1964,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
                 move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);            
             }
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }    
@@ -2821,16 +1978,16 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
     for (int i = 0; i < 4; i++) {     
         // for (int k = 0; k < 3; k++) {
-        //     printf("id1: %d - %d\n", k, positions_sides[id1][k]);
+        //     solver_log(ctx, "id1: %d - %d\n", k, positions_sides[id1][k]);
         // }
         // for (int k = 0; k < 3; k++) {
-        //     printf("id2: %d - %d\n", k, positions_sides[id2][k]);
+        //     solver_log(ctx, "id2: %d - %d\n", k, positions_sides[id2][k]);
         // }
         // for (int k = 0; k < 3; k++) {
-        //     printf("id3: %d - %d\n", k, positions_sides[id3][k]);
+        //     solver_log(ctx, "id3: %d - %d\n", k, positions_sides[id3][k]);
         // }
         // for (int k = 0; k < 3; k++) {
-        //     printf("id4: %d - %d\n", k, positions_sides[id4][k]);
+        //     solver_log(ctx, "id4: %d - %d\n", k, positions_sides[id4][k]);
         // } 
         // V Permutation
          if (
@@ -2838,7 +1995,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id2][1] == positions_sides[id2][0] &&
             positions_sides[id2][2] == positions_sides[id3][1]
         ) {
-            printf("V Permutation\n");
+            solver_log(ctx, "V Permutation\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -2864,7 +2021,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_CLOCKWISE), cubeColors);
                 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -2875,7 +2032,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id1][2] == positions_sides[id1][1] &&
             positions_sides[id4][1] == positions_sides[id4][0]
         ) {
-            printf("Y Permutation\n");
+            solver_log(ctx, "Y Permutation\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -2903,7 +2060,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
 
 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -2915,7 +2072,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id1][0] == positions_sides[id1][1] &&
             positions_sides[id3][0] == positions_sides[id3][1]
         ) {
-            printf("N Permutation : a\n");
+            solver_log(ctx, "N Permutation : a\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -2936,7 +2093,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             }
 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -2949,7 +2106,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id1][2] == positions_sides[id1][1] &&
             positions_sides[id3][2] == positions_sides[id3][1]
         ) {
-            printf("N Permutation : b\n");
+            solver_log(ctx, "N Permutation : b\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -2970,7 +2127,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
             
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -2983,7 +2140,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id4][1] == positions_sides[id2][0] &&
             positions_sides[id4][1] == positions_sides[id2][2]
         ) {
-            printf("G Permutation : a\n");
+            solver_log(ctx, "G Permutation : a\n");
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
                 get_side_positions(cubeColors, positions_sides);
@@ -3010,7 +2167,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
             
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, moves[idx-1], cubeColors);
             }    
@@ -3023,7 +2180,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id4][2] == positions_sides[id3][1] && 
             positions_sides[id3][0] == positions_sides[id3][2]
         ) {
-            printf("G Permutation : b\n");
+            solver_log(ctx, "G Permutation : b\n");
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
                 get_side_positions(cubeColors, positions_sides);
@@ -3046,7 +2203,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(face4, ROTATE_180), cubeColors);
 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -3058,7 +2215,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id2][1] == positions_sides[id4][0] &&
             positions_sides[id4][2] == positions_sides[id2][1]
         ) {
-            printf("G Permutation : c\n");
+            solver_log(ctx, "G Permutation : c\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -3087,7 +2244,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(face, ROTATE_COUNTERCLOCKWISE), cubeColors);
 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, moves[idx-1], cubeColors);
             }
@@ -3099,7 +2256,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id2][0] == positions_sides[id3][1] &&
             positions_sides[id4][2] == positions_sides[id3][1]
         ) {
-            printf("G Permutation : d\n");
+            solver_log(ctx, "G Permutation : d\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -3128,7 +2285,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(face3, ROTATE_CLOCKWISE), cubeColors);
             
             int idx = (positions_sides[3][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -3140,7 +2297,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id1][2] == positions_sides[id1][1] && 
             positions_sides[id3][1] == positions_sides[id3][0]
         ) {
-            printf("T Permutation\n");
+            solver_log(ctx, "T Permutation\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -3173,7 +2330,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id2][1] == positions_sides[id3][0] &&
             positions_sides[id2][1] == positions_sides[id4][2]
         ) {
-            printf("R Permutation : a\n");
+            solver_log(ctx, "R Permutation : a\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -3199,7 +2356,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_CLOCKWISE), cubeColors);
 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -3212,7 +2369,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             positions_sides[id4][1] == positions_sides[id2][0] &&
             positions_sides[id4][1] == positions_sides[id3][2]
         ) {
-            printf("R Permutation : b\n");
+            solver_log(ctx, "R Permutation : b\n");
 
             if (id1 != 0) {
                 move_sequence_add(solution, moves[id1-1], cubeColors);
@@ -3238,7 +2395,7 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
             move_sequence_add(solution, get_move_from_face_and_direction(FACE_IDX_BOTTOM, ROTATE_COUNTERCLOCKWISE), cubeColors);
 
             int idx = (positions_sides[0][1] - 1);
-            printf("idx: %d\n", idx);
+            solver_log(ctx, "idx: %d\n", idx);
             if (idx != 0) {
                 move_sequence_add(solution, return_moves[idx-1], cubeColors);
             }
@@ -3252,14 +2409,14 @@ static void solve_PLL(RGBColor (*cubeColors)[9], MoveSequence* solution) {
     }
 }
 
-static void fix_lower(RGBColor (*cubeColors)[9], MoveSequence* solution){
+static void fix_lower(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution){
     int positions_sides[4][3];
     get_side_positions(cubeColors, positions_sides);
 
     Move return_moves[] = {MOVE_D, MOVE_D2, MOVE_D_PRIME};
 
     int id = positions_sides[0][1] - 1;
-    printf("%d", id);
+    solver_log(ctx, "%d", id);
     if (id != 0)
     {
         move_sequence_add(solution, return_moves[id-1], cubeColors);
@@ -3267,39 +2424,239 @@ static void fix_lower(RGBColor (*cubeColors)[9], MoveSequence* solution){
 }
 
 
-char** cube_solver_solve(Scene* scene, bool* isSolved) {
-    if (!scene) {
-        printf("Error: Invalid scene\n");
-        return NULL;
+typedef void (*SolverStage)(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution);
+
+static long long stage_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Время и число ходов этапа; склейка потом может добавить этапу поворот D
+static void run_stage(SolverContext* ctx, SolverStageId id, SolverStage stage, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    int before = solution->count;
+    long long start = stage_clock_ns();
+    stage(ctx, cubeColors, solution);
+    ctx->stage_stats.ns[id] += stage_clock_ns() - start;
+    ctx->stage_stats.moves[id] = solution->count - before;
+}
+
+// Тот же ход после поворота всего куба на quarters четвертей вокруг вертикали: боковые грани идут по кругу
+static Move shift_side_move(Move move, int quarters) {
+    FaceIndex face = move_to_face(move);
+    if (face == FACE_IDX_TOP || face == FACE_IDX_BOTTOM) return move;
+    return get_move_from_face_and_direction((FaceIndex)((face - 1 + quarters) % 4 + 1), move_to_direction(move));
+}
+
+// Сколько последних ходов решения участвует в оценке склейки
+#define STITCH_TAIL 8
+
+// Поворот D на quarters четвертей по часовой; MOVE_COUNT - без поворота
+static const Move d_turns[4] = {MOVE_COUNT, MOVE_D, MOVE_D2, MOVE_D_PRIME};
+
+static int d_quarters(Move move) {
+    for (int q = 1; q < 4; q++) {
+        if (d_turns[q] == move) return q;
     }
-    
-    printf("Starting Rubik's cube solver...\n");
-    
-    if (is_cube_solved(scene->cubeColors)) {
-        printf("Cube is already solved!\n");
-        char** moveSequence = malloc(sizeof(char*));
-        moveSequence[0] = NULL;
-        *isSolved = true;
-        return moveSequence;
+    return -1;
+}
+
+// Алгоритм этапа во всех четырёх поворотах куба подряд: shifted + quarters * count
+static Move* shift_all(SolverContext* ctx, const MoveSequence* algorithm) {
+    // +1: пустой алгоритм (пропуск этапа) тоже получает буфер
+    Move* shifted = solver_arena_alloc(&ctx->arena, 4 * algorithm->count * sizeof(Move) + 1);
+    if (!shifted) return NULL;
+    for (int q = 0; q < 4; q++) {
+        for (int i = 0; i < algorithm->count; i++) {
+            shifted[q * algorithm->count + i] = shift_side_move(algorithm->moves[i], q);
+        }
+    }
+    return shifted;
+}
+
+// Записывает D^quarters и алгоритм в out, возвращает число записанных ходов
+static int put_turned(Move* out, int quarters, const Move* algorithm, int count) {
+    int written = 0;
+    if (quarters != 0) out[written++] = d_turns[quarters];
+    memcpy(out + written, algorithm, count * sizeof(Move));
+    return written + count;
+}
+
+static void append_moves(MoveSequence* solution, const MoveSequence* moves) {
+    for (int i = 0; i < moves->count; i++) {
+        move_sequence_push(solution, moves->moves[i]);
+    }
+}
+
+/*
+    Последний слой со склейкой: перед OLL и перед PLL пробуется поворот D,
+    D2 или D', чтобы лишний D и другая ориентация алгоритма склеились с
+    концом предыдущего этапа. При собранных первых двух слоях D^j перед
+    этапом - то же, что поворот всего куба на j четвертей, поэтому каждый
+    этап распознаётся один раз, а для поворота его алгоритм только
+    переименовывается (боковые грани сдвигаются на j) и меняется итоговый
+    доворот D. Из 16 вариантов берётся самый дешёвый после склейки ходов.
+*/
+static void solve_last_layer(SolverContext* ctx, RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    if (!ctx->options.stitching) {
+        run_stage(ctx, SOLVER_STAGE_OLL, solve_OLL, cubeColors, solution);
+        run_stage(ctx, SOLVER_STAGE_PLL, solve_PLL, cubeColors, solution);
+        run_stage(ctx, SOLVER_STAGE_FIX_LOWER, fix_lower, cubeColors, solution);
+        return;
+    }
+
+    // Обычный проход; его ходы пока пишутся отдельно, цвета сразу конечные
+    MoveSequence oll, pll, auf;
+    move_sequence_init_scratch(ctx, &oll);
+    move_sequence_init_scratch(ctx, &pll);
+    move_sequence_init_scratch(ctx, &auf);
+    run_stage(ctx, SOLVER_STAGE_OLL, solve_OLL, cubeColors, &oll);
+    run_stage(ctx, SOLVER_STAGE_PLL, solve_PLL, cubeColors, &pll);
+    run_stage(ctx, SOLVER_STAGE_FIX_LOWER, fix_lower, cubeColors, &auf);
+
+    // Каждый вариант тоже собирает куб, но только если первые два слоя были собраны
+    int auf_quarters = auf.count == 0 ? 0 : d_quarters(auf.moves[0]);
+    // Склейка дальше нескольких последних ходов F2L почти не доходит, начало решения у всех вариантов общее
+    int tail = solution->count < STITCH_TAIL ? solution->count : STITCH_TAIL;
+    int capacity = tail + oll.count + pll.count + 3;
+    if (!is_cube_solved((const RGBColor (*)[9])cubeColors) || auf.count > 1 || auf_quarters < 0) {
+        append_moves(solution, &oll);
+        append_moves(solution, &pll);
+        append_moves(solution, &auf);
+        return;
+    }
+
+    Move* best = solver_arena_alloc(&ctx->arena, 3 * capacity * sizeof(Move));
+    Move* oll_shifted = best ? shift_all(ctx, &oll) : NULL;
+    Move* pll_shifted = oll_shifted ? shift_all(ctx, &pll) : NULL;
+    // Без памяти сборка уже отмечена проваленной
+    if (!pll_shifted) return;
+    Move* prefix = best + capacity;
+    Move* candidate = prefix + capacity;
+
+    int best_count = 0;
+    int best_cost = -1;
+    int best_oll = 0;
+    int best_pll = 0;
+    for (int j = 0; j < 4; j++) {
+        // Конец F2L и OLL склеиваются один раз, варианты PLL продолжают готовый результат
+        const Move* oll_moves = oll_shifted + j * oll.count;
+        memcpy(prefix, solution->moves + solution->count - tail, tail * sizeof(Move));
+        int merged = move_optimizer_merge(prefix, tail + put_turned(prefix + tail, j, oll_moves, oll.count));
+
+        for (int k = 0; k < 4; k++) {
+            const Move* pll_moves = pll_shifted + (j + k) % 4 * pll.count;
+            memcpy(candidate, prefix, merged * sizeof(Move));
+            int count = merged + put_turned(candidate + merged, k, pll_moves, pll.count);
+            int last = ((auf_quarters - j - k) % 4 + 4) % 4;
+            if (last != 0) candidate[count++] = d_turns[last];
+
+            int cost = solver_sequence_cost(&ctx->options, candidate, move_optimizer_merge_onto(candidate, merged, count));
+            if (best_cost < 0 || cost < best_cost) {
+                best_count = put_turned(best, j, oll_moves, oll.count);
+                best_count += put_turned(best + best_count, k, pll_moves, pll.count);
+                if (last != 0) best[best_count++] = d_turns[last];
+                best_cost = cost;
+                best_oll = j;
+                best_pll = k;
+            }
+        }
+    }
+
+    for (int i = 0; i < best_count; i++) {
+        move_sequence_push(solution, best[i]);
     }
+
+    // Поворот D засчитывается этапу, ради которого сделан
+    ctx->stage_stats.moves[SOLVER_STAGE_OLL] = oll.count + (best_oll != 0);
+    ctx->stage_stats.moves[SOLVER_STAGE_PLL] = pll.count + (best_pll != 0);
+    ctx->stage_stats.moves[SOLVER_STAGE_FIX_LOWER] = best_count - ctx->stage_stats.moves[SOLVER_STAGE_OLL] -
+                                                     ctx->stage_stats.moves[SOLVER_STAGE_PLL];
+}
+
+// Решение остаётся в арене контекста до следующей сборки; true, если куб собран
+static bool solve_into(SolverContext* ctx, const RGBColor (*cubeColors)[9], MoveSequence* solution) {
+    solver_log(ctx, "Starting Rubik's cube solver...\n");
+    ctx->stats.solves++;
+
+    // Всё временное предыдущей сборки освобождается разом
+    solver_arena_reset(&ctx->arena);
+    memset(&ctx->stage_stats, 0, sizeof(ctx->stage_stats));
+    move_sequence_init_scratch(ctx, solution);
     
+    if (is_cube_solved(cubeColors)) {
+        solver_log(ctx, "Cube is already solved!\n");
+        ctx->stats.solved++;
+        return true;
+    }
+
+    // Несобираемое состояние отсекаем до всех этапов
+    CubeStateError error = cube_state_validate(cubeColors);
+    if (error != CUBE_STATE_VALID) {
+        solver_log(ctx, "Invalid cube state: %s\n", cube_state_error_string(error));
+        return false;
+    }
+
     RGBColor working_colors[6][9];
-    copy_cube_state(scene->cubeColors, working_colors);
+    copy_cube_state(cubeColors, working_colors);
+
+    // То же состояние (с точностью до поворота и перекраски) уже решалось
+    SolverCacheKey key;
+    if (ctx->cache) {
+        solver_cache_make_key(cubeColors, &ctx->options, &key);
+
+        Move cached[SOLVER_CACHE_MAX_MOVES];
+        int count = solver_cache_lookup(ctx->cache, &key, cached, SOLVER_CACHE_MAX_MOVES);
+        if (count >= 0) {
+            for (int i = 0; i < count; i++) {
+                move_sequence_add(solution, cached[i], working_colors);
+            }
+            solver_log(ctx, "Solution from cache: %d moves\n", solution->count);
+
+            ctx->stats.total_moves += solution->count;
+            ctx->stats.total_cost += solver_sequence_cost(&ctx->options, solution->moves, solution->count);
+            if (ctx->arena.failed || !is_cube_solved(working_colors)) return false;
+            ctx->stats.solved++;
+            return true;
+        }
+    }
     
+    run_stage(ctx, SOLVER_STAGE_CROSS, ctx->options.xcross ? solve_xcross : solve_white_cross, working_colors, solution);
+    run_stage(ctx, SOLVER_STAGE_F2L, solve_F2L, working_colors, solution);
+    solve_last_layer(ctx, working_colors, solution);
+
+    int before_simplify = solution->count;
+    long long simplify_start = stage_clock_ns();
+    simplify_move_sequence(ctx, solution);
+    ctx->stage_stats.ns[SOLVER_STAGE_SIMPLIFY] = stage_clock_ns() - simplify_start;
+    ctx->stage_stats.moves[SOLVER_STAGE_SIMPLIFY] = solution->count - before_simplify;
+    solver_log(ctx, "Solver completed with %d moves\n", solution->count);
+
+    ctx->stats.total_moves += solution->count;
+    ctx->stats.total_cost += solver_sequence_cost(&ctx->options, solution->moves, solution->count);
+    if (ctx->arena.failed) {
+        solver_log(ctx, "Out of memory, solve abandoned\n");
+        return false;
+    }
+    if (!is_cube_solved(working_colors)) return false;
+    ctx->stats.solved++;
+
+    if (ctx->cache) {
+        solver_cache_store(ctx->cache, &key, solution->moves, solution->count);
+    }
+    return true;
+}
+
+char** cube_solver_solve_ctx(SolverContext* ctx, const RGBColor (*cubeColors)[9], bool* isSolved) {
+    if (!ctx || !cubeColors) {
+        return NULL;
+    }
+
     MoveSequence solution;
-    move_sequence_init(&solution);
-    
-    solve_white_cross(working_colors, &solution);
-    solve_F2L(working_colors, &solution);
-    solve_OLL(working_colors, &solution);
-    solve_PLL(working_colors, &solution);
-    fix_lower(working_colors, &solution);
-    simplify_move_sequence(&solution);
-    printf("Solver completed with %d moves\n", solution.count);
+    *isSolved = solve_into(ctx, cubeColors, &solution);
     
     char** moveSequence = malloc((solution.count + 1) * sizeof(char*));
     if (!moveSequence) {
-        move_sequence_destroy(&solution);
         return NULL;
     }
     
@@ -3313,27 +2670,251 @@ char** cube_solver_solve(Scene* scene, bool* isSolved) {
                 free(moveSequence[j]);
             }
             free(moveSequence);
-            move_sequence_destroy(&solution);
             return NULL;
         }
     }
     
     moveSequence[solution.count] = NULL;
-    printf("{");
-    for (int i = 0; i < solution.count; ++i) {
-        if (i > 0) printf(", ");
-        printf("\"%s\"", moveSequence[i]);
+    if (solution.count > 0) {
+        solver_log(ctx, "{");
+        for (int i = 0; i < solution.count; ++i) {
+            if (i > 0) solver_log(ctx, ", ");
+            solver_log(ctx, "\"%s\"", moveSequence[i]);
+        }
+        solver_log(ctx, ", NULL};\n");
     }
-    printf(", NULL};\n");
     
-    move_sequence_destroy(&solution);
+    return moveSequence;
+}
+
+// Цвета для букв состояния - те же, что у собранного куба в сцене
+static bool cube_state_letter_color(char letter, RGBColor* color) {
+    switch (letter) {
+        case 'W': case 'w': *color = (RGBColor){1.0f, 1.0f, 1.0f}; return true;
+        case 'R': case 'r': *color = (RGBColor){1.0f, 0.0f, 0.0f}; return true;
+        case 'B': case 'b': *color = (RGBColor){0.0f, 0.0f, 1.0f}; return true;
+        case 'O': case 'o': *color = (RGBColor){1.0f, 0.5f, 0.0f}; return true;
+        case 'G': case 'g': *color = (RGBColor){0.0f, 0.8f, 0.0f}; return true;
+        case 'Y': case 'y': *color = (RGBColor){1.0f, 1.0f, 0.0f}; return true;
+        default: return false;
+    }
+}
 
-    if (is_cube_solved(working_colors)) {
-        *isSolved = true;
+bool cube_state_to_colors(const CubeState* state, RGBColor (*cubeColors)[9]) {
+    for (int face = 0; face < 6; face++) {
+        for (int pos = 0; pos < 9; pos++) {
+            if (!cube_state_letter_color(state->facelets[face * 9 + pos], &cubeColors[face][pos])) {
+                return false;
+            }
+        }
     }
-    else {
-        *isSolved = false;
+    return true;
+}
+
+bool cube_state_from_colors(const RGBColor (*cubeColors)[9], CubeState* state) {
+    static const char letters[] = "WRBOGY";
+    for (int face = 0; face < 6; face++) {
+        for (int pos = 0; pos < 9; pos++) {
+            char letter = '\0';
+            for (int i = 0; i < 6 && !letter; i++) {
+                RGBColor color;
+                cube_state_letter_color(letters[i], &color);
+                if (colors_equal(cubeColors[face][pos], color)) letter = letters[i];
+            }
+            if (!letter) return false;
+            state->facelets[face * 9 + pos] = letter;
+        }
     }
-    
-    return moveSequence;
-} 
+    return true;
+}
+
+void cube_solver_solve_state(SolverContext* ctx, const CubeState* state, SolveResult* result) {
+    result->solved = false;
+    result->count = -1;
+
+    RGBColor colors[6][9];
+    if (!cube_state_to_colors(state, colors)) return;
+
+    MoveSequence solution;
+    bool solved = solve_into(ctx, (const RGBColor (*)[9])colors, &solution);
+    if (solution.count > SOLVE_RESULT_MAX_MOVES) return;
+
+    result->solved = solved;
+    result->count = solution.count;
+    if (solution.count > 0) memcpy(result->moves, solution.moves, solution.count * sizeof(Move));
+}
+
+#define BATCH_CHUNK 16
+// С кэшем пакет идёт порциями постоянного размера, не зависящего от числа потоков
+#define BATCH_ROUND 256
+
+typedef enum {
+    BATCH_NO_KEY,  // Кэш выключен или состояние не прочитано / несобираемо
+    BATCH_KEYED,   // Ключ есть, в кэше решения не нашлось
+    BATCH_CACHED   // Решение взято из кэша
+} BatchSlot;
+
+typedef struct {
+    const CubeState* in;
+    SolveResult* out;
+    size_t count;
+    SolverOptions options;
+    SolverCache* cache;  // Один кэш на весь пакет
+    SolverCacheKey* keys; // Ключи текущей порции (только с кэшем)
+    unsigned char* slots; // BatchSlot текущей порции
+    size_t round_start;
+    size_t round_end;
+    bool keys_pass;       // Проход вычисляет ключи, а не собирает
+    atomic_size_t next;   // Первый ещё не взятый куб
+} BatchJob;
+
+static void batch_make_key(const BatchJob* job, size_t i) {
+    size_t slot = i - job->round_start;
+    job->slots[slot] = BATCH_NO_KEY;
+
+    RGBColor colors[6][9];
+    if (!cube_state_to_colors(&job->in[i], colors)) return;
+    if (cube_state_validate((const RGBColor (*)[9])colors) != CUBE_STATE_VALID) return;
+    solver_cache_make_key((const RGBColor (*)[9])colors, &job->options, &job->keys[slot]);
+    job->slots[slot] = BATCH_KEYED;
+}
+
+// Решение из кэша проверяется так же, как в solve_into
+static void batch_check_cached(const CubeState* state, SolveResult* result) {
+    RGBColor colors[6][9];
+    cube_state_to_colors(state, colors);
+    for (int i = 0; i < result->count; i++) {
+        apply_move_to_cube_colors(colors, result->moves[i]);
+    }
+    result->solved = is_cube_solved((const RGBColor (*)[9])colors);
+}
+
+// Каждый поток со своим контекстом берёт кубы порциями, пока они не кончатся
+static void* batch_worker(void* arg) {
+    BatchJob* job = arg;
+
+    SolverContext ctx;
+    solver_context_init(&ctx, &job->options);
+    ctx.log = NULL;
+
+    for (;;) {
+        size_t start = atomic_fetch_add(&job->next, BATCH_CHUNK);
+        if (start >= job->round_end) break;
+
+        size_t end = start + BATCH_CHUNK < job->round_end ? start + BATCH_CHUNK : job->round_end;
+        for (size_t i = start; i < end; i++) {
+            if (job->keys_pass) {
+                batch_make_key(job, i);
+            } else if (job->cache && job->slots[i - job->round_start] == BATCH_CACHED) {
+                batch_check_cached(&job->in[i], &job->out[i]);
+            } else {
+                cube_solver_solve_state(&ctx, &job->in[i], &job->out[i]);
+            }
+        }
+    }
+
+    solver_context_destroy(&ctx);
+    return NULL;
+}
+
+static void batch_pass(BatchJob* job, bool keys_pass, size_t threads) {
+    job->keys_pass = keys_pass;
+    atomic_store(&job->next, job->round_start);
+
+    size_t chunks = (job->round_end - job->round_start + BATCH_CHUNK - 1) / BATCH_CHUNK;
+    if (threads > chunks) threads = chunks > 0 ? chunks : 1;
+    solver_run_threads((int)threads, batch_worker, job);
+}
+
+/*
+    С кэшем каждая порция идёт в четыре шага: ключи (параллельно), поиск в
+    кэше по порядку входа, сборка промахов (параллельно), запись новых
+    решений по порядку входа. Кэш меняется только в последовательных шагах,
+    поэтому что найдётся в кэше, не зависит ни от числа потоков, ни от того,
+    какой поток успел раньше.
+*/
+static void batch_cached_round(BatchJob* job, size_t threads) {
+    batch_pass(job, true, threads);
+
+    for (size_t i = job->round_start; i < job->round_end; i++) {
+        size_t slot = i - job->round_start;
+        if (job->slots[slot] != BATCH_KEYED) continue;
+
+        int count = solver_cache_lookup(job->cache, &job->keys[slot], job->out[i].moves, SOLVE_RESULT_MAX_MOVES);
+        if (count >= 0) {
+            job->out[i].count = count;
+            job->slots[slot] = BATCH_CACHED;
+        }
+    }
+
+    batch_pass(job, false, threads);
+
+    for (size_t i = job->round_start; i < job->round_end; i++) {
+        size_t slot = i - job->round_start;
+        if (job->slots[slot] == BATCH_KEYED && job->out[i].solved) {
+            solver_cache_store(job->cache, &job->keys[slot], job->out[i].moves, job->out[i].count);
+        }
+    }
+}
+
+int cube_solver_solve_batch(const CubeState* in, size_t n, SolveResult* out, const SolverOptions* options) {
+    if ((!in || !out) && n > 0) return -1;
+
+    BatchJob job;
+    job.in = in;
+    job.out = out;
+    job.count = n;
+    if (options) {
+        job.options = *options;
+    } else {
+        solver_options_init(&job.options);
+    }
+
+    // Кэш общий для всех потоков; контексты своих не заводят и в него не ходят - это делает сам пакет
+    job.cache = job.options.cache_bytes > 0 ? solver_cache_create(job.options.cache_bytes) : NULL;
+    job.options.cache_bytes = 0;
+    job.keys = job.cache ? solver_heap_alloc(sizeof(SolverCacheKey) * BATCH_ROUND) : NULL;
+    job.slots = job.cache ? solver_heap_alloc(BATCH_ROUND) : NULL;
+    if (!job.keys || !job.slots) {
+        solver_heap_free(job.keys);
+        solver_heap_free(job.slots);
+        solver_cache_destroy(job.cache);
+        job.cache = NULL;
+    }
+
+    size_t threads = job.options.threads > 1 ? (size_t)job.options.threads : 1;
+    if (!job.cache) {
+        job.round_start = 0;
+        job.round_end = n;
+        batch_pass(&job, false, threads);
+        return 0;
+    }
+
+    for (size_t start = 0; start < n; start += BATCH_ROUND) {
+        job.round_start = start;
+        job.round_end = start + BATCH_ROUND < n ? start + BATCH_ROUND : n;
+        batch_cached_round(&job, threads);
+    }
+
+    solver_heap_free(job.keys);
+    solver_heap_free(job.slots);
+    solver_cache_destroy(job.cache);
+    return 0;
+}
+
+int solver_run_threads(int threads, void* (*worker)(void*), void* arg) {
+    if (threads > SOLVER_MAX_THREADS) threads = SOLVER_MAX_THREADS;
+
+    // Вызывающий поток работает сам, дополнительные потоки - только если их попросили
+    pthread_t workers[SOLVER_MAX_THREADS];
+    int started = 0;
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&workers[started], NULL, worker, arg) != 0) break;
+        started++;
+    }
+    worker(arg);
+    for (int t = 0; t < started; t++) {
+        pthread_join(workers[t], NULL);
+    }
+    return started + 1;
+}
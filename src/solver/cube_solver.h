@@ -2,7 +2,8 @@
 #define CUBE_SOLVER_H
 
 #include <stdbool.h>
-#include "../scene/scene.h"
+#include "../cube_state.h"
+#include "solver_arena.h"
 
 typedef enum {
     MOVE_U,
@@ -23,7 +24,51 @@ typedef enum {
     MOVE_L, 
     MOVE_L_PRIME, 
     MOVE_L2, 
-    MOVE_COUNT
+    MOVE_COUNT,
+
+    /*
+        Срезы, широкие ходы и повороты всего куба - для записи и исполнения
+        алгоритмов. Поиск решения и таблицы деталей работают только с первыми
+        MOVE_COUNT ходами граней. M идёт как L, E - как D, S - как F;
+        Rw = R + M', x - как R, y - как U, z - как F.
+    */
+    MOVE_M = MOVE_COUNT,
+    MOVE_M_PRIME,
+    MOVE_M2,
+    MOVE_E,
+    MOVE_E_PRIME,
+    MOVE_E2,
+    MOVE_S,
+    MOVE_S_PRIME,
+    MOVE_S2,
+    MOVE_UW,
+    MOVE_UW_PRIME,
+    MOVE_UW2,
+    MOVE_DW,
+    MOVE_DW_PRIME,
+    MOVE_DW2,
+    MOVE_FW,
+    MOVE_FW_PRIME,
+    MOVE_FW2,
+    MOVE_BW,
+    MOVE_BW_PRIME,
+    MOVE_BW2,
+    MOVE_RW,
+    MOVE_RW_PRIME,
+    MOVE_RW2,
+    MOVE_LW,
+    MOVE_LW_PRIME,
+    MOVE_LW2,
+    MOVE_X,
+    MOVE_X_PRIME,
+    MOVE_X2,
+    MOVE_Y,
+    MOVE_Y_PRIME,
+    MOVE_Y2,
+    MOVE_Z,
+    MOVE_Z_PRIME,
+    MOVE_Z2,
+    MOVE_EXTENDED_COUNT
 } Move;
 
 
@@ -31,10 +76,136 @@ typedef struct {
     Move* moves;
     int count;
     int capacity;
+    SolverArena* arena; // NULL - буфер в куче, иначе в арене решателя (destroy ничего не освобождает)
 } MoveSequence;
 
-char** cube_solver_solve(Scene* scene, bool* isSolved);
-void cube_solver_set_quiet(bool quiet);
+/*
+    Цена хода, которую минимизирует поиск (XCross, F2L, склейка этапов, окно)
+    и которую показывает бенчмарк. Повороты всего куба во всех метриках
+    бесплатны.
+*/
+typedef enum {
+    SOLVER_METRIC_HTM,   // Поворот грани или широкий ход - 1, срез - 2
+    SOLVER_METRIC_QTM,   // Четверть оборота - 1, пол-оборота - 2, срез - вдвое дороже
+    SOLVER_METRIC_STM,   // Любой поворот любого слоя - 1
+    SOLVER_METRIC_CUSTOM // Цены заданы прямо в move_cost
+} SolverMetric;
+
+typedef struct {
+    bool multislot; // F2L: лучевой поиск по порядку слотов вместо самой дешёвой пары
+    bool xcross;    // Крест и первая пара одним поиском вместо solve_white_cross
+    bool window;    // Замена окон решения более короткими эквивалентами из таблицы
+    bool stitching; // Поворот D перед OLL и PLL, выбранный по склейке ходов
+    int threads;    // Потоки для cube_solver_solve_batch и бенчмарка (1 - только вызывающий поток)
+    size_t cache_bytes; // Кэш решений, создаваемый вместе с контекстом (0 - без кэша)
+    SolverMetric metric;
+    unsigned char move_cost[MOVE_EXTENDED_COUNT]; // Цена каждого хода; у ходов граней не меньше 1
+} SolverOptions;
+
+#define SOLVER_MAX_THREADS 64
+
+typedef struct SolverCache SolverCache;
+
+typedef struct {
+    unsigned long solves;
+    unsigned long solved;
+    unsigned long total_moves;
+    unsigned long total_cost; // В метрике options.metric
+} SolverStats;
+
+// Этапы сборки 3x3 в порядке выполнения
+typedef enum {
+    SOLVER_STAGE_CROSS,     // solve_white_cross или XCross
+    SOLVER_STAGE_F2L,
+    SOLVER_STAGE_OLL,
+    SOLVER_STAGE_PLL,
+    SOLVER_STAGE_FIX_LOWER,
+    SOLVER_STAGE_SIMPLIFY,
+    SOLVER_STAGE_COUNT
+} SolverStageId;
+
+// Разбивка последней сборки контекста по этапам (нули, если решение взято из кэша)
+typedef struct {
+    long long ns[SOLVER_STAGE_COUNT]; // Время этапа; выбор поворотов при склейке сюда не входит
+    int moves[SOLVER_STAGE_COUNT];    // Ходы этапа в выбранном решении; у simplify - изменение длины (<= 0)
+} SolverStageStats;
+
+// Receives one formatted log message; user is SolverContext.log_user
+typedef void (*SolverLogFn)(void* user, const char* message);
+
+/*
+    Всё состояние одной цепочки сборок: настройки, куда писать лог, временная
+    память и статистика. Контексты независимы - каждый поток берёт свой, и
+    сборки в них идут параллельно с разными настройками.
+*/
+typedef struct {
+    SolverOptions options;
+    SolverLogFn log; // NULL - без лога
+    void* log_user;
+    SolverArena arena;
+    SolverStats stats;
+    SolverStageStats stage_stats;
+    SolverCache* cache; // NULL - без кэша; можно подставить общий для нескольких контекстов
+    bool owns_cache;
+} SolverContext;
+
+// Defaults: every optional stage off, stage stitching on, no cache, half-turn metric
+void solver_options_init(SolverOptions* options);
+// Fills move_cost for a standard metric; SOLVER_METRIC_CUSTOM keeps the current costs
+void solver_options_set_metric(SolverOptions* options, SolverMetric metric);
+const char* solver_stage_name(SolverStageId stage);
+const char* solver_metric_name(SolverMetric metric);
+// Accepts "htm", "qtm", "stm" and "custom"
+bool solver_metric_from_string(const char* text, SolverMetric* metric);
+int solver_move_cost(const SolverOptions* options, Move move);
+int solver_sequence_cost(const SolverOptions* options, const Move* moves, int count);
+// Builds the lookup tables these options use (F2L, XCross pruning, window); called by solver_context_init
+void solver_warm_up(const SolverOptions* options);
+// options may be NULL for defaults; logging goes to stdout until ctx->log is changed
+void solver_context_init(SolverContext* ctx, const SolverOptions* options);
+void solver_context_destroy(SolverContext* ctx);
+void solver_log_stdout(void* user, const char* message);
+
+// Result is a NULL-terminated, caller-owned array of heap strings
+char** cube_solver_solve_ctx(SolverContext* ctx, const RGBColor (*cubeColors)[9], bool* isSolved);
+
+/*
+    Состояние куба для пакетной сборки: 54 буквы цветов (W, R, B, O, G, Y)
+    в том же порядке, что и строка состояния сцены - грани по FaceIndex,
+    внутри грани позиции 0..8.
+*/
+typedef struct {
+    char facelets[54];
+} CubeState;
+
+#define SOLVE_RESULT_MAX_MOVES 192
+
+typedef struct {
+    bool solved;
+    int count; // -1 - состояние не прочитано или решение не поместилось
+    Move moves[SOLVE_RESULT_MAX_MOVES];
+} SolveResult;
+
+// False if a facelet is not one of the six colour letters
+bool cube_state_to_colors(const CubeState* state, RGBColor (*cubeColors)[9]);
+// Inverse of cube_state_to_colors; false if a facelet is none of the six colours
+bool cube_state_from_colors(const RGBColor (*cubeColors)[9], CubeState* state);
+// Single-cube form of the batch API, on the caller's context
+void cube_solver_solve_state(SolverContext* ctx, const CubeState* state, SolveResult* result);
+
+/*
+    Solves in[0..n) into out[0..n). Tables, scratch memory and the (silent)
+    context are set up once per thread, not per cube; options->threads > 1
+    splits the batch across worker threads. With cache_bytes > 0 the batch
+    shares one cache and goes in fixed rounds: lookups and stores happen
+    between rounds in input order, so a repeat of a cube from an earlier
+    round reuses its solution. Results do not depend on the thread count
+    either way. Returns 0, or -1 on invalid arguments.
+*/
+int cube_solver_solve_batch(const CubeState* in, size_t n, SolveResult* out, const SolverOptions* options);
+// Runs worker(arg) on the caller and threads - 1 extra threads (at most SOLVER_MAX_THREADS in all),
+// joins them and returns how many ran; a failed pthread_create just leaves fewer workers
+int solver_run_threads(int threads, void* (*worker)(void*), void* arg);
 void move_sequence_init(MoveSequence* sequence);
 void move_sequence_add(MoveSequence* sequence, Move move, RGBColor (*cubeColors)[9]);
 void move_sequence_destroy(MoveSequence* sequence);
@@ -42,11 +213,31 @@ void move_sequence_print(const MoveSequence* sequence);
 
 Move get_move_from_face_and_direction(FaceIndex face, RotationDirection direction);
 void apply_move_to_cube_colors(RGBColor (*cubeColors)[9], Move move);
+// Calls of apply_move_to_cube_colors made so far by the calling thread
+unsigned long long solver_applied_moves(void);
+// One quarter turn (or half turn split by the caller) of the facelet colours
+void rotate_face_colors(RGBColor (*cubeColors)[9], FaceIndex face, RotationDirection direction);
 void copy_cube_state(const RGBColor (*source)[9], RGBColor (*dest)[9]);
 bool is_cube_solved(const RGBColor (*cubeColors)[9]);
 
+// Шаги решателя, открытые для микробенчмарков (tools/bench_kernels.c)
+// Facelets of the edge with these two colours, in the order of the colours
+bool find_edge_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RGBColor color2,
+                     FaceIndex* face1, int* pos1, FaceIndex* face2, int* pos2);
+// Facelets of the corner with these three colours, in the order of the colours
+bool find_corner_piece(const RGBColor (*cubeColors)[9], RGBColor color1, RGBColor color2, RGBColor color3,
+                       FaceIndex* face1, int* pos1, FaceIndex* face2, int* pos2, FaceIndex* face3, int* pos3);
+// Merges moves and, with options.window, replaces windows by cheaper equivalents
+void simplify_move_sequence(const SolverContext* ctx, MoveSequence* sequence);
+
 const char* move_to_string(Move move);
+// Parses one whole move token: "R", "U2", "M'", "Rw2", "x'"; lowercase face letters are plain face turns
+bool move_from_string(const char* text, Move* move);
+// Face the move turns along with (M - L, E - D, S - F, x - R, y - U, z - F)
 FaceIndex move_to_face(Move move);
 RotationDirection move_to_direction(Move move);
+// Layers turned, counted from move_to_face: bit 0 - the face layer, bit 1 - middle, bit 2 - opposite face
+int move_to_layers(Move move);
+Move move_inverse(Move move);
 
 #endif /* CUBE_SOLVER_H */ 
@@ -0,0 +1,128 @@
+#include "cube_validate.h"
+#include "cubie_cube.h"
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#define NO_PIECE 0xFF
+
+static bool colors_match(RGBColor a, RGBColor b) {
+    const float tolerance = 0.1f;
+    return fabs(a.r - b.r) < tolerance &&
+           fabs(a.g - b.g) < tolerance &&
+           fabs(a.b - b.b) < tolerance;
+}
+
+// Чётность перестановки через число циклов: n - циклы
+static int permutation_parity(const unsigned char* perm, int n) {
+    bool seen[CUBIE_EDGE_COUNT] = {false};
+    int cycles = 0;
+    for (int i = 0; i < n; i++) {
+        if (seen[i]) continue;
+        cycles++;
+        for (int j = i; !seen[j]; j = perm[j]) {
+            seen[j] = true;
+        }
+    }
+    return (n - cycles) & 1;
+}
+
+CubeStateError cube_state_validate(const RGBColor (*cubeColors)[9]) {
+    for (int f = 0; f < 6; f++) {
+        for (int g = f + 1; g < 6; g++) {
+            if (colors_match(cubeColors[f][4], cubeColors[g][4])) return CUBE_STATE_DUPLICATE_CENTER;
+        }
+    }
+
+    // Каждая наклейка -> грань, чей центр того же цвета
+    unsigned char faces[6][9];
+    int counts[6] = {0};
+    for (int f = 0; f < 6; f++) {
+        for (int p = 0; p < 9; p++) {
+            int face = -1;
+            for (int c = 0; c < 6 && face < 0; c++) {
+                if (colors_match(cubeColors[f][p], cubeColors[c][4])) face = c;
+            }
+            if (face < 0) return CUBE_STATE_UNKNOWN_COLOR;
+            faces[f][p] = (unsigned char)face;
+            counts[face]++;
+        }
+    }
+    for (int f = 0; f < 6; f++) {
+        if (counts[f] != 9) return CUBE_STATE_WRONG_COLOR_COUNT;
+    }
+
+    // Угол по тройке граней (по часовой, начиная с U/D-наклейки) -> деталь
+    unsigned char corner_piece[6 * 6 * 6];
+    memset(corner_piece, NO_PIECE, sizeof(corner_piece));
+    for (int j = 0; j < CUBIE_CORNER_COUNT; j++) {
+        int a = cubie_corner_facelets[j][0][0], b = cubie_corner_facelets[j][1][0], c = cubie_corner_facelets[j][2][0];
+        corner_piece[(a * 6 + b) * 6 + c] = (unsigned char)j;
+    }
+    unsigned char edge_piece[6 * 6];
+    memset(edge_piece, NO_PIECE, sizeof(edge_piece));
+    for (int j = 0; j < CUBIE_EDGE_COUNT; j++) {
+        edge_piece[cubie_edge_facelets[j][0][0] * 6 + cubie_edge_facelets[j][1][0]] = (unsigned char)j;
+    }
+
+    CubieCube cube;
+    bool used[CUBIE_EDGE_COUNT] = {false};
+    int twist_sum = 0;
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        int s[3];
+        for (int k = 0; k < 3; k++) {
+            s[k] = faces[cubie_corner_facelets[i][k][0]][cubie_corner_facelets[i][k][1]];
+        }
+
+        // Поворот - какая из наклеек позиции несёт U/D-цвет детали
+        int piece = NO_PIECE, twist = 0;
+        for (int t = 0; t < 3 && piece == NO_PIECE; t++) {
+            piece = corner_piece[(s[t] * 6 + s[(t + 1) % 3]) * 6 + s[(t + 2) % 3]];
+            twist = t;
+        }
+        if (piece == NO_PIECE || used[piece]) return CUBE_STATE_INVALID_CORNER;
+        used[piece] = true;
+        cube.cp[i] = (unsigned char)piece;
+        twist_sum += twist;
+    }
+
+    memset(used, 0, sizeof(used));
+    int flip_sum = 0;
+    for (int i = 0; i < CUBIE_EDGE_COUNT; i++) {
+        int s0 = faces[cubie_edge_facelets[i][0][0]][cubie_edge_facelets[i][0][1]];
+        int s1 = faces[cubie_edge_facelets[i][1][0]][cubie_edge_facelets[i][1][1]];
+
+        int piece = edge_piece[s0 * 6 + s1];
+        int flip = 0;
+        if (piece == NO_PIECE) {
+            piece = edge_piece[s1 * 6 + s0];
+            flip = 1;
+        }
+        if (piece == NO_PIECE || used[piece]) return CUBE_STATE_INVALID_EDGE;
+        used[piece] = true;
+        cube.ep[i] = (unsigned char)piece;
+        flip_sum += flip;
+    }
+
+    if (twist_sum % 3 != 0) return CUBE_STATE_TWISTED_CORNER;
+    if (flip_sum % 2 != 0) return CUBE_STATE_FLIPPED_EDGE;
+    if (permutation_parity(cube.cp, CUBIE_CORNER_COUNT) != permutation_parity(cube.ep, CUBIE_EDGE_COUNT)) {
+        return CUBE_STATE_PARITY;
+    }
+    return CUBE_STATE_VALID;
+}
+
+const char* cube_state_error_string(CubeStateError error) {
+    switch (error) {
+        case CUBE_STATE_VALID: return "valid";
+        case CUBE_STATE_DUPLICATE_CENTER: return "two centres have the same colour";
+        case CUBE_STATE_UNKNOWN_COLOR: return "a sticker does not match any centre";
+        case CUBE_STATE_WRONG_COLOR_COUNT: return "a colour does not appear exactly 9 times";
+        case CUBE_STATE_INVALID_CORNER: return "a corner piece does not exist or appears twice";
+        case CUBE_STATE_INVALID_EDGE: return "an edge piece does not exist or appears twice";
+        case CUBE_STATE_TWISTED_CORNER: return "a corner is twisted";
+        case CUBE_STATE_FLIPPED_EDGE: return "an edge is flipped";
+        case CUBE_STATE_PARITY: return "two pieces are swapped (permutation parity)";
+        default: return "unknown error";
+    }
+}
@@ -0,0 +1,28 @@
+#ifndef CUBE_VALIDATE_H
+#define CUBE_VALIDATE_H
+
+#include "../cube_state.h"
+
+typedef enum {
+    CUBE_STATE_VALID = 0,
+    CUBE_STATE_DUPLICATE_CENTER,   // Два центра одного цвета
+    CUBE_STATE_UNKNOWN_COLOR,      // Наклейка не совпадает ни с одним центром
+    CUBE_STATE_WRONG_COLOR_COUNT,  // Какого-то цвета не 9 наклеек
+    CUBE_STATE_INVALID_CORNER,     // Такого угла нет на кубе или он встречается дважды
+    CUBE_STATE_INVALID_EDGE,       // То же для ребра
+    CUBE_STATE_TWISTED_CORNER,     // Сумма поворотов углов не делится на 3
+    CUBE_STATE_FLIPPED_EDGE,       // Сумма переворотов рёбер нечётная
+    CUBE_STATE_PARITY              // Чётности перестановок углов и рёбер различаются
+} CubeStateError;
+
+/*
+    Checks that the colours describe a cube reachable by face turns, in one
+    pass over the stickers and pieces. The first failing check is reported,
+    in the order of the enum above. Colours are matched to the centres with
+    the solver's tolerance, so any six distinct centre colours work.
+*/
+CubeStateError cube_state_validate(const RGBColor (*cubeColors)[9]);
+
+const char* cube_state_error_string(CubeStateError error);
+
+#endif /* CUBE_VALIDATE_H */
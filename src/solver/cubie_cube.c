@@ -0,0 +1,135 @@
+#include "cubie_cube.h"
+#include <math.h>
+
+void cubie_cube_init_solved(CubieCube* cube) {
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        cube->cp[i] = (unsigned char)i;
+        cube->co[i] = 0;
+    }
+    for (int i = 0; i < CUBIE_EDGE_COUNT; i++) {
+        cube->ep[i] = (unsigned char)i;
+        cube->eo[i] = 0;
+    }
+}
+
+static bool colors_match(RGBColor a, RGBColor b) {
+    const float tolerance = 0.1f;
+    return fabs(a.r - b.r) < tolerance &&
+           fabs(a.g - b.g) < tolerance &&
+           fabs(a.b - b.b) < tolerance;
+}
+
+// Грань, центр которой совпадает по цвету со стикером
+static int color_to_face(const RGBColor (*cubeColors)[9], RGBColor color) {
+    for (int f = 0; f < 6; f++) {
+        if (colors_match(cubeColors[f][4], color)) {
+            return f;
+        }
+    }
+    return -1;
+}
+
+bool cubie_cube_from_colors(CubieCube* cube, const RGBColor (*cubeColors)[9]) {
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        int faces[3];
+        for (int s = 0; s < 3; s++) {
+            faces[s] = color_to_face(cubeColors, cubeColors[cubie_corner_facelets[i][s][0]][cubie_corner_facelets[i][s][1]]);
+        }
+
+        bool found = false;
+        for (int j = 0; j < CUBIE_CORNER_COUNT && !found; j++) {
+            for (int twist = 0; twist < 3 && !found; twist++) {
+                if (faces[0] == cubie_corner_facelets[j][(3 - twist) % 3][0] &&
+                    faces[1] == cubie_corner_facelets[j][(4 - twist) % 3][0] &&
+                    faces[2] == cubie_corner_facelets[j][(5 - twist) % 3][0]) {
+                    cube->cp[i] = (unsigned char)j;
+                    cube->co[i] = (unsigned char)twist;
+                    found = true;
+                }
+            }
+        }
+        if (!found) return false;
+    }
+
+    for (int i = 0; i < CUBIE_EDGE_COUNT; i++) {
+        int face0 = color_to_face(cubeColors, cubeColors[cubie_edge_facelets[i][0][0]][cubie_edge_facelets[i][0][1]]);
+        int face1 = color_to_face(cubeColors, cubeColors[cubie_edge_facelets[i][1][0]][cubie_edge_facelets[i][1][1]]);
+
+        bool found = false;
+        for (int j = 0; j < CUBIE_EDGE_COUNT && !found; j++) {
+            for (int flip = 0; flip < 2 && !found; flip++) {
+                if (face0 == cubie_edge_facelets[j][flip][0] && face1 == cubie_edge_facelets[j][1 - flip][0]) {
+                    cube->ep[i] = (unsigned char)j;
+                    cube->eo[i] = (unsigned char)flip;
+                    found = true;
+                }
+            }
+        }
+        if (!found) return false;
+    }
+
+    return true;
+}
+
+// Обратно к cubie_cube_from_colors: цвет наклейки - цвет центра грани, к которой она принадлежит у детали
+void cubie_cube_to_colors(const CubieCube* cube, RGBColor (*cubeColors)[9]) {
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        int j = cube->cp[i];
+        for (int s = 0; s < 3; s++) {
+            int face = cubie_corner_facelets[j][(3 + s - cube->co[i]) % 3][0];
+            cubeColors[cubie_corner_facelets[i][s][0]][cubie_corner_facelets[i][s][1]] = cubeColors[face][4];
+        }
+    }
+    for (int i = 0; i < CUBIE_EDGE_COUNT; i++) {
+        int j = cube->ep[i];
+        for (int s = 0; s < 2; s++) {
+            int face = cubie_edge_facelets[j][s ^ cube->eo[i]][0];
+            cubeColors[cubie_edge_facelets[i][s][0]][cubie_edge_facelets[i][s][1]] = cubeColors[face][4];
+        }
+    }
+}
+
+// Таблицы ходов сгенерированы tools/gen_move_tables.c (move_tables.h)
+void cubie_cube_apply_move(CubieCube* cube, Move move) {
+    CubieCube prev = *cube;
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        int src = cubie_corner_move_src[move][i];
+        cube->cp[i] = prev.cp[src];
+        cube->co[i] = (unsigned char)((prev.co[src] + cubie_corner_move_twist[move][i]) % 3);
+    }
+    for (int i = 0; i < CUBIE_EDGE_COUNT; i++) {
+        int src = cubie_edge_move_src[move][i];
+        cube->ep[i] = prev.ep[src];
+        cube->eo[i] = prev.eo[src] ^ cubie_edge_move_flip[move][i];
+    }
+}
+
+int cubie_corner_position(const CubieCube* cube, int corner, int* twist) {
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        if (cube->cp[i] == corner) {
+            if (twist) *twist = cube->co[i];
+            return i;
+        }
+    }
+    return -1;
+}
+
+int cubie_edge_position(const CubieCube* cube, int edge, int* flip) {
+    for (int i = 0; i < CUBIE_EDGE_COUNT; i++) {
+        if (cube->ep[i] == edge) {
+            if (flip) *flip = cube->eo[i];
+            return i;
+        }
+    }
+    return -1;
+}
+
+int cubie_corner_move_dest(Move move, int position, int* twist_delta) {
+    if (twist_delta) *twist_delta = cubie_corner_move_to_twist[move][position];
+    return cubie_corner_move_to[move][position];
+}
+
+int cubie_edge_move_dest(Move move, int position, int* flip_delta) {
+    if (flip_delta) *flip_delta = cubie_edge_move_to_flip[move][position];
+    return cubie_edge_move_to[move][position];
+}
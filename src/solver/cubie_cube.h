@@ -0,0 +1,40 @@
+#ifndef CUBIE_CUBE_H
+#define CUBIE_CUBE_H
+
+#include <stdbool.h>
+#include "cube_solver.h"
+#include "move_tables.h"
+
+#define CUBIE_CORNER_COUNT 8
+#define CUBIE_EDGE_COUNT 12
+
+/*
+    Кубик на уровне деталей (cubie level).
+    Позиции углов:  0 UFL, 1 URF, 2 ULB, 3 UBR, 4 DBL, 5 DRB, 6 DLF, 7 DFR
+    Позиции рёбер:  0 UF, 1 UL, 2 UR, 3 UB, 4 DB, 5 DL, 6 DR, 7 DF,
+                    8 FL, 9 FR, 10 BL, 11 BR
+    Деталь с номером i "живёт" в позиции i собранного куба.
+*/
+typedef struct {
+    unsigned char cp[CUBIE_CORNER_COUNT]; // Какой угол стоит в позиции
+    unsigned char co[CUBIE_CORNER_COUNT]; // Его поворот (0..2)
+    unsigned char ep[CUBIE_EDGE_COUNT];   // Какое ребро стоит в позиции
+    unsigned char eo[CUBIE_EDGE_COUNT];   // Его переворот (0..1)
+} CubieCube;
+
+void cubie_cube_init_solved(CubieCube* cube);
+bool cubie_cube_from_colors(CubieCube* cube, const RGBColor (*cubeColors)[9]);
+// Writes corner and edge facelets; the centres already in cubeColors give the face colours
+void cubie_cube_to_colors(const CubieCube* cube, RGBColor (*cubeColors)[9]);
+// Face turns only (move < MOVE_COUNT): the cubie model keeps the centres fixed
+void cubie_cube_apply_move(CubieCube* cube, Move move);
+
+// Where a piece currently is; twist/flip written to the optional out parameter
+int cubie_corner_position(const CubieCube* cube, int corner, int* twist);
+int cubie_edge_position(const CubieCube* cube, int edge, int* flip);
+
+// Per-move destination of the piece at a position (for coordinate tables)
+int cubie_corner_move_dest(Move move, int position, int* twist_delta);
+int cubie_edge_move_dest(Move move, int position, int* flip_delta);
+
+#endif /* CUBIE_CUBE_H */
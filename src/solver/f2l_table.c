@@ -0,0 +1,379 @@
+#include "f2l_table.h"
+#include <string.h>
+#include <pthread.h>
+
+#define F2L_UNREACHABLE 0xFF
+#define F2L_TRIGGER_COUNT 6
+#define F2L_EXTRACT_DEPTH 2
+#define F2L_ORDER_COUNT 24
+
+static const struct {
+    FaceIndex face, face2;
+    int corner, edge;
+} f2l_slots[F2L_SLOT_COUNT] = {
+    {FACE_IDX_FRONT, FACE_IDX_RIGHT, 1, 9},
+    {FACE_IDX_RIGHT, FACE_IDX_BACK,  3, 11},
+    {FACE_IDX_BACK,  FACE_IDX_LEFT,  2, 10},
+    {FACE_IDX_LEFT,  FACE_IDX_FRONT, 0, 8},
+};
+
+typedef struct {
+    int length;
+    Move moves[3];
+} F2LMacro;
+
+typedef struct {
+    unsigned char length;
+    unsigned char moves[F2L_MAX_ALG];
+} F2LAlg;
+
+// Триггеры слота: X D^k X', где X уводит пару в нижний слой, не трогая крест и другие слоты
+static F2LMacro g_triggers[F2L_SLOT_COUNT][F2L_TRIGGER_COUNT];
+static F2LAlg g_table[F2L_SLOT_COUNT][F2L_PAIR_STATES];
+static pthread_once_t g_table_once = PTHREAD_ONCE_INIT;
+
+static const Move down_moves[] = {MOVE_D, MOVE_D2, MOVE_D_PRIME};
+
+static int encode_pair(int corner_pos, int twist, int edge_pos, int flip) {
+    return (corner_pos * 3 + twist) * 24 + edge_pos * 2 + flip;
+}
+
+static int pair_apply_move(int state, Move move) {
+    int edge = state % 24;
+    int corner = state / 24;
+
+    int twist_delta, flip_delta;
+    int corner_pos = cubie_corner_move_dest(move, corner / 3, &twist_delta);
+    int edge_pos = cubie_edge_move_dest(move, edge / 2, &flip_delta);
+
+    return encode_pair(corner_pos, (corner % 3 + twist_delta) % 3, edge_pos, (edge % 2) ^ flip_delta);
+}
+
+static int rotation_quarters(Move move) {
+    RotationDirection dir = move_to_direction(move);
+    if (dir == ROTATE_CLOCKWISE) return 1;
+    if (dir == ROTATE_COUNTERCLOCKWISE) return 3;
+    return 2;
+}
+
+// Добавить ход, склеивая с предыдущим ходом той же грани
+static void append_merged(Move* moves, int* count, Move move) {
+    if (*count > 0 && move_to_face(moves[*count - 1]) == move_to_face(move)) {
+        int q = (rotation_quarters(moves[*count - 1]) + rotation_quarters(move)) % 4;
+        if (q == 0) {
+            (*count)--;
+        } else {
+            RotationDirection dir = (q == 1) ? ROTATE_CLOCKWISE : (q == 2) ? ROTATE_180 : ROTATE_COUNTERCLOCKWISE;
+            moves[*count - 1] = get_move_from_face_and_direction(move_to_face(move), dir);
+        }
+        return;
+    }
+    moves[(*count)++] = move;
+}
+
+static bool in_down_layer_corner(int pos) { return pos >= 4; }
+static bool in_down_layer_edge(int pos) { return pos >= 4 && pos < 8; }
+
+// Face turn takes the slot pair down while every protected piece stays out of the D layer
+static bool trigger_is_valid(int slot, Move move) {
+    if (!in_down_layer_corner(cubie_corner_move_dest(move, f2l_slots[slot].corner, NULL)) ||
+        !in_down_layer_edge(cubie_edge_move_dest(move, f2l_slots[slot].edge, NULL))) {
+        return false;
+    }
+
+    for (int e = 0; e < 4; e++) {
+        if (in_down_layer_edge(cubie_edge_move_dest(move, e, NULL))) return false;
+    }
+    for (int s = 0; s < F2L_SLOT_COUNT; s++) {
+        if (s == slot) continue;
+        if (in_down_layer_corner(cubie_corner_move_dest(move, f2l_slots[s].corner, NULL)) ||
+            in_down_layer_edge(cubie_edge_move_dest(move, f2l_slots[s].edge, NULL))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void init_triggers(int slot) {
+    FaceIndex faces[] = {f2l_slots[slot].face, f2l_slots[slot].face2};
+    int count = 0;
+
+    for (int f = 0; f < 2; f++) {
+        for (int d = 0; d < 2; d++) {
+            RotationDirection dir = d == 0 ? ROTATE_CLOCKWISE : ROTATE_COUNTERCLOCKWISE;
+            Move move = get_move_from_face_and_direction(faces[f], dir);
+            if (!trigger_is_valid(slot, move)) continue;
+
+            for (int k = 0; k < 3 && count < F2L_TRIGGER_COUNT; k++) {
+                g_triggers[slot][count].length = 3;
+                g_triggers[slot][count].moves[0] = move;
+                g_triggers[slot][count].moves[1] = down_moves[k];
+                g_triggers[slot][count].moves[2] = get_move_from_face_and_direction(faces[f], -dir);
+                count++;
+            }
+        }
+    }
+}
+
+static void init_slot_table(int slot) {
+    F2LAlg* table = g_table[slot];
+    for (int s = 0; s < F2L_PAIR_STATES; s++) {
+        table[s].length = F2L_UNREACHABLE;
+    }
+    table[encode_pair(f2l_slots[slot].corner, 0, f2l_slots[slot].edge, 0)].length = 0;
+
+    // Макро-ходы: подстройка нижнего слоя и триггеры слота
+    F2LMacro macros[3 + F2L_TRIGGER_COUNT];
+    int macro_count = 0;
+    for (int k = 0; k < 3; k++) {
+        macros[macro_count].length = 1;
+        macros[macro_count].moves[0] = down_moves[k];
+        macro_count++;
+    }
+    for (int t = 0; t < F2L_TRIGGER_COUNT; t++) {
+        macros[macro_count++] = g_triggers[slot][t];
+    }
+
+    // Релаксация до неподвижной точки: table[s] = лучший (macro + table[macro(s)])
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int s = 0; s < F2L_PAIR_STATES; s++) {
+            for (int m = 0; m < macro_count; m++) {
+                int t = s;
+                for (int i = 0; i < macros[m].length; i++) {
+                    t = pair_apply_move(t, macros[m].moves[i]);
+                }
+                if (t == s || table[t].length == F2L_UNREACHABLE) continue;
+
+                Move candidate[F2L_MAX_ALG + 3];
+                int count = 0;
+                for (int i = 0; i < macros[m].length; i++) {
+                    append_merged(candidate, &count, macros[m].moves[i]);
+                }
+                for (int i = 0; i < table[t].length; i++) {
+                    append_merged(candidate, &count, (Move)table[t].moves[i]);
+                }
+
+                if (count < table[s].length && count <= F2L_MAX_ALG) {
+                    table[s].length = (unsigned char)count;
+                    for (int i = 0; i < count; i++) {
+                        table[s].moves[i] = (unsigned char)candidate[i];
+                    }
+                    changed = true;
+                }
+            }
+        }
+    }
+}
+
+static void build_tables(void) {
+    for (int slot = 0; slot < F2L_SLOT_COUNT; slot++) {
+        init_triggers(slot);
+        init_slot_table(slot);
+    }
+}
+
+void f2l_init(void) {
+    pthread_once(&g_table_once, build_tables);
+}
+
+int f2l_pair_index(const CubieCube* cube, int slot) {
+    int twist, flip;
+    int corner_pos = cubie_corner_position(cube, f2l_slots[slot].corner, &twist);
+    int edge_pos = cubie_edge_position(cube, f2l_slots[slot].edge, &flip);
+    return encode_pair(corner_pos, twist, edge_pos, flip);
+}
+
+bool f2l_slot_solved(const CubieCube* cube, int slot) {
+    int corner = f2l_slots[slot].corner;
+    int edge = f2l_slots[slot].edge;
+    return cube->cp[corner] == corner && cube->co[corner] == 0 &&
+           cube->ep[edge] == edge && cube->eo[edge] == 0;
+}
+
+// Слот, в котором застряла деталь пары (или -1, если она в нижнем слое / своём слоте)
+static int stuck_in_slot(const CubieCube* cube, int slot) {
+    int corner_pos = cubie_corner_position(cube, f2l_slots[slot].corner, NULL);
+    int edge_pos = cubie_edge_position(cube, f2l_slots[slot].edge, NULL);
+
+    for (int s = 0; s < F2L_SLOT_COUNT; s++) {
+        if (s == slot) continue;
+        if (corner_pos == f2l_slots[s].corner || edge_pos == f2l_slots[s].edge) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+// Цена ходов по таблице move_cost, без таблицы - просто их число
+static int plan_cost(const unsigned char* move_cost, const Move* moves, int count) {
+    if (!move_cost) return count;
+    int cost = 0;
+    for (int i = 0; i < count; i++) {
+        cost += move_cost[moves[i]];
+    }
+    return cost;
+}
+
+static int plan_pair(const CubieCube* cube, int slot, const unsigned char* move_cost, Move* out, int max_moves, int depth) {
+    const F2LAlg* alg = &g_table[slot][f2l_pair_index(cube, slot)];
+    if (alg->length != F2L_UNREACHABLE) {
+        if (alg->length > max_moves) return -1;
+        for (int i = 0; i < alg->length; i++) {
+            out[i] = (Move)alg->moves[i];
+        }
+        return alg->length;
+    }
+
+    int other = stuck_in_slot(cube, slot);
+    if (other < 0 || depth <= 0) return -1;
+
+    // Вытаскиваем деталь из чужого слота его же триггером и берём самый дешёвый итог
+    int best = -1;
+    int best_cost = 0;
+    Move best_moves[F2L_MAX_PLAN];
+    for (int t = 0; t < F2L_TRIGGER_COUNT; t++) {
+        const F2LMacro* trigger = &g_triggers[other][t];
+        CubieCube next = *cube;
+        for (int i = 0; i < trigger->length; i++) {
+            cubie_cube_apply_move(&next, trigger->moves[i]);
+        }
+
+        Move rest[F2L_MAX_PLAN];
+        int rest_count = plan_pair(&next, slot, move_cost, rest, F2L_MAX_PLAN, depth - 1);
+        if (rest_count < 0) continue;
+
+        Move candidate[F2L_MAX_PLAN + 3];
+        int count = 0;
+        for (int i = 0; i < trigger->length; i++) {
+            append_merged(candidate, &count, trigger->moves[i]);
+        }
+        for (int i = 0; i < rest_count; i++) {
+            append_merged(candidate, &count, rest[i]);
+        }
+
+        int cost = plan_cost(move_cost, candidate, count);
+        if (count <= max_moves && count <= F2L_MAX_PLAN && (best < 0 || cost < best_cost)) {
+            best = count;
+            best_cost = cost;
+            memcpy(best_moves, candidate, count * sizeof(Move));
+        }
+    }
+
+    if (best > 0) {
+        memcpy(out, best_moves, best * sizeof(Move));
+    }
+    return best;
+}
+
+int f2l_plan_pair(const CubieCube* cube, int slot, Move* out, int max_moves) {
+    f2l_init();
+
+    if (f2l_slot_solved(cube, slot)) return 0;
+    return plan_pair(cube, slot, NULL, out, max_moves, F2L_EXTRACT_DEPTH);
+}
+
+typedef struct {
+    CubieCube cube;
+    int count;
+    int cost;
+    Move moves[F2L_MAX_TOTAL];
+} F2LNode;
+
+static bool all_slots_solved(const CubieCube* cube) {
+    for (int slot = 0; slot < F2L_SLOT_COUNT; slot++) {
+        if (!f2l_slot_solved(cube, slot)) return false;
+    }
+    return true;
+}
+
+// Продолжение узла парой slot; false, если пару не поставить
+static bool expand_node(const F2LNode* node, int slot, const unsigned char* move_cost, F2LNode* child) {
+    Move moves[F2L_MAX_PLAN];
+    int count = plan_pair(&node->cube, slot, move_cost, moves, F2L_MAX_PLAN, F2L_EXTRACT_DEPTH);
+    if (count < 0 || node->count + count > F2L_MAX_TOTAL) return false;
+
+    *child = *node;
+    for (int i = 0; i < count; i++) {
+        append_merged(child->moves, &child->count, moves[i]);
+        cubie_cube_apply_move(&child->cube, moves[i]);
+    }
+    child->cost = plan_cost(move_cost, child->moves, child->count);
+    return true;
+}
+
+/*
+    Лучевой поиск по порядку слотов: на каждом уровне каждый узел продолжается
+    всеми нерешёнными парами, остаются beam_width самых дешёвых.
+    Перебор последовательный: на уровне не больше 32 продолжений по долям
+    микросекунды, запуск потоков обходится дороже, а сборки и так идут
+    параллельно в cube_solver_solve_batch. Ширина 8 вместо всех 24 порядков:
+    полный перебор в полтора раза медленнее и экономит около 0.1 хода.
+*/
+int f2l_plan(const CubieCube* cube, int beam_width, const unsigned char* move_cost, SolverArena* arena, Move* out,
+             int max_moves) {
+    f2l_init();
+
+    if (beam_width < 1) beam_width = 1;
+    if (beam_width > F2L_ORDER_COUNT) beam_width = F2L_ORDER_COUNT;
+
+    int beam_count = 1;
+    size_t mark = solver_arena_mark(arena);
+    F2LNode* beam = solver_arena_alloc(arena, sizeof(F2LNode) * beam_width);
+    F2LNode* children = solver_arena_alloc(arena, sizeof(F2LNode) * beam_width * F2L_SLOT_COUNT);
+    bool* valid = solver_arena_alloc(arena, sizeof(bool) * beam_width * F2L_SLOT_COUNT);
+    if (!beam || !children || !valid) {
+        solver_arena_rewind(arena, mark);
+        return -1;
+    }
+
+    beam[0].cube = *cube;
+    beam[0].count = 0;
+    beam[0].cost = 0;
+
+    for (int depth = 0; depth < F2L_SLOT_COUNT; depth++) {
+        int jobs = beam_count * F2L_SLOT_COUNT;
+
+        for (int j = 0; j < jobs; j++) {
+            const F2LNode* node = &beam[j / F2L_SLOT_COUNT];
+            int slot = j % F2L_SLOT_COUNT;
+
+            if (all_slots_solved(&node->cube)) {
+                // Готовый узел переходит на следующий уровень как есть (один раз)
+                valid[j] = slot == 0;
+                if (valid[j]) children[j] = *node;
+            } else {
+                valid[j] = !f2l_slot_solved(&node->cube, slot) && expand_node(node, slot, move_cost, &children[j]);
+            }
+        }
+
+        // Отбираем лучшие; при равенстве остаётся более ранний порядок, результат детерминирован
+        beam_count = 0;
+        for (int pick = 0; pick < beam_width; pick++) {
+            int best = -1;
+            for (int j = 0; j < jobs; j++) {
+                if (valid[j] && (best < 0 || children[j].cost < children[best].cost)) {
+                    best = j;
+                }
+            }
+            if (best < 0) break;
+            beam[beam_count++] = children[best];
+            valid[best] = false;
+        }
+
+        if (beam_count == 0) break;
+    }
+
+    int result = -1;
+    for (int i = 0; i < beam_count; i++) {
+        if (all_slots_solved(&beam[i].cube) && beam[i].count <= max_moves) {
+            result = beam[i].count;
+            memcpy(out, beam[i].moves, result * sizeof(Move));
+            break;
+        }
+    }
+
+    solver_arena_rewind(arena, mark);
+    return result;
+}
@@ -0,0 +1,36 @@
+#ifndef F2L_TABLE_H
+#define F2L_TABLE_H
+
+#include <stdbool.h>
+#include "cube_solver.h"
+#include "cubie_cube.h"
+#include "solver_arena.h"
+
+#define F2L_SLOT_COUNT 4
+// Состояние пары: позиция и поворот угла (8 * 3) x позиция и переворот ребра (12 * 2)
+#define F2L_PAIR_STATES (8 * 3 * 12 * 2)
+#define F2L_MAX_ALG 24
+#define F2L_MAX_PLAN 32
+#define F2L_MAX_TOTAL (F2L_SLOT_COUNT * F2L_MAX_PLAN)
+// Ширина луча при переборе порядка слотов (24 = все порядки, но дороже почти без выигрыша)
+#define F2L_BEAM_WIDTH 8
+
+/*
+    Слоты F2L (белый крест сверху, последний слой снизу):
+    0 - FRONT/RIGHT, 1 - RIGHT/BACK, 2 - BACK/LEFT, 3 - LEFT/FRONT
+*/
+// Builds the pair tables now instead of inside the first plan
+void f2l_init(void);
+int f2l_pair_index(const CubieCube* cube, int slot);
+bool f2l_slot_solved(const CubieCube* cube, int slot);
+
+// Shortest known insertion for the pair; returns move count or -1 if the pair cannot be solved
+int f2l_plan_pair(const CubieCube* cube, int slot, Move* out, int max_moves);
+
+// Whole F2L; beam_width 1 inserts the cheapest pair next, wider beams compare slot orders.
+// Costs come from move_cost (indexed by Move, NULL - every move 1); the pair tables stay shortest-first.
+// Beam buffers are taken from the arena and given back before returning. Runs on the calling thread.
+int f2l_plan(const CubieCube* cube, int beam_width, const unsigned char* move_cost, SolverArena* arena, Move* out,
+             int max_moves);
+
+#endif /* F2L_TABLE_H */
@@ -0,0 +1,230 @@
+#include "move_optimizer.h"
+#include "cubie_cube.h"
+#include <string.h>
+#include <pthread.h>
+
+#define WINDOW_TABLE_BITS 17
+#define WINDOW_TABLE_SIZE (1 << WINDOW_TABLE_BITS)
+#define WINDOW_EMPTY 0xFF
+
+typedef struct {
+    unsigned long long hash;
+    unsigned char length;
+    unsigned char moves[MOVE_OPTIMIZER_TABLE_DEPTH];
+} WindowEntry;
+
+// Все состояния, достижимые за <= 4 хода, с кратчайшей последовательностью
+static WindowEntry g_window_table[WINDOW_TABLE_SIZE];
+static pthread_once_t g_window_once = PTHREAD_ONCE_INIT;
+
+static int rotation_quarters(Move move) {
+    RotationDirection dir = move_to_direction(move);
+    if (dir == ROTATE_CLOCKWISE) return 1;
+    if (dir == ROTATE_COUNTERCLOCKWISE) return 3;
+    return 2;
+}
+
+static bool opposite_faces(FaceIndex a, FaceIndex b) {
+    return (a == FACE_IDX_TOP && b == FACE_IDX_BOTTOM) || (a == FACE_IDX_BOTTOM && b == FACE_IDX_TOP) ||
+           (a == FACE_IDX_FRONT && b == FACE_IDX_BACK) || (a == FACE_IDX_BACK && b == FACE_IDX_FRONT) ||
+           (a == FACE_IDX_RIGHT && b == FACE_IDX_LEFT) || (a == FACE_IDX_LEFT && b == FACE_IDX_RIGHT);
+}
+
+// Склеить два хода одной грани; false, если они взаимно уничтожились
+static bool combine_moves(Move a, Move b, Move* result) {
+    int q = (rotation_quarters(a) + rotation_quarters(b)) % 4;
+    if (q == 0) return false;
+
+    RotationDirection dir = (q == 1) ? ROTATE_CLOCKWISE : (q == 2) ? ROTATE_180 : ROTATE_COUNTERCLOCKWISE;
+    *result = get_move_from_face_and_direction(move_to_face(a), dir);
+    return true;
+}
+
+// Стек уже упрощённых ходов: новый ход склеивается с вершиной или с ходом под противоположной гранью
+static void push_move(Move* out, int* count, Move move) {
+    int n = *count;
+    FaceIndex face = move_to_face(move);
+
+    // Срезы, широкие ходы и повороты не склеиваются и ничего не пропускают через себя
+    if (move >= MOVE_COUNT || (n > 0 && out[n - 1] >= MOVE_COUNT)) {
+        out[n] = move;
+        *count = n + 1;
+        return;
+    }
+
+    if (n > 0 && move_to_face(out[n - 1]) == face) {
+        Move merged;
+        if (combine_moves(out[n - 1], move, &merged)) {
+            out[n - 1] = merged;
+        } else {
+            *count = n - 1;
+        }
+        return;
+    }
+
+    if (n > 1 && out[n - 2] < MOVE_COUNT && opposite_faces(move_to_face(out[n - 1]), face) &&
+        move_to_face(out[n - 2]) == face) {
+        Move between = out[n - 1];
+        Move merged;
+        bool kept = combine_moves(out[n - 2], move, &merged);
+        *count = n - 2;
+        if (kept) push_move(out, count, merged);
+        // Ход между ними может теперь склеиться с тем, что лежит ниже
+        push_move(out, count, between);
+        return;
+    }
+
+    out[n] = move;
+    *count = n + 1;
+
+    // Коммутирующая пара противоположных граней - в каноническом порядке
+    if (n > 0 && opposite_faces(move_to_face(out[n - 1]), face) && face < move_to_face(out[n - 1])) {
+        out[n] = out[n - 1];
+        out[n - 1] = move;
+    }
+}
+
+int move_optimizer_merge(Move* moves, int count) {
+    return move_optimizer_merge_onto(moves, 0, count);
+}
+
+int move_optimizer_merge_onto(Move* moves, int merged, int count) {
+    int out_count = merged;
+    for (int i = merged; i < count; i++) {
+        push_move(moves, &out_count, moves[i]);
+    }
+    return out_count;
+}
+
+static unsigned long long cube_hash(const CubieCube* cube) {
+    const unsigned char* bytes = (const unsigned char*)cube;
+    unsigned long long hash = 1469598103934665603ULL;
+    for (size_t i = 0; i < sizeof(CubieCube); i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static WindowEntry* find_slot(unsigned long long hash) {
+    size_t index = (size_t)(hash >> (64 - WINDOW_TABLE_BITS));
+    while (g_window_table[index].length != WINDOW_EMPTY && g_window_table[index].hash != hash) {
+        index = (index + 1) & (WINDOW_TABLE_SIZE - 1);
+    }
+    return &g_window_table[index];
+}
+
+static void fill_table(CubieCube* cube, int depth, int target, int last_face, Move* path) {
+    if (depth == target) {
+        WindowEntry* entry = find_slot(cube_hash(cube));
+        if (entry->length == WINDOW_EMPTY) {
+            entry->hash = cube_hash(cube);
+            entry->length = (unsigned char)depth;
+            for (int i = 0; i < depth; i++) {
+                entry->moves[i] = (unsigned char)path[i];
+            }
+        }
+        return;
+    }
+
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        FaceIndex face = move_to_face((Move)m);
+        if ((int)face == last_face) continue;
+        if (last_face >= 0 && opposite_faces(face, last_face) && (int)face < last_face) continue;
+
+        CubieCube next = *cube;
+        cubie_cube_apply_move(&next, (Move)m);
+        path[depth] = (Move)m;
+        fill_table(&next, depth + 1, target, face, path);
+    }
+}
+
+static void build_window_table(void) {
+    for (int i = 0; i < WINDOW_TABLE_SIZE; i++) {
+        g_window_table[i].length = WINDOW_EMPTY;
+    }
+
+    // По возрастанию глубины, чтобы в таблице осталась самая короткая запись
+    Move path[MOVE_OPTIMIZER_TABLE_DEPTH];
+    for (int depth = 0; depth <= MOVE_OPTIMIZER_TABLE_DEPTH; depth++) {
+        CubieCube solved;
+        cubie_cube_init_solved(&solved);
+        fill_table(&solved, 0, depth, -1, path);
+    }
+}
+
+void move_optimizer_init(void) {
+    pthread_once(&g_window_once, build_window_table);
+}
+
+// Запись таблицы для этого состояния (с проверкой на коллизию хэша) или NULL
+static const WindowEntry* lookup(const CubieCube* cube) {
+    const WindowEntry* entry = find_slot(cube_hash(cube));
+    if (entry->length == WINDOW_EMPTY) return NULL;
+
+    CubieCube check;
+    cubie_cube_init_solved(&check);
+    for (int i = 0; i < entry->length; i++) {
+        cubie_cube_apply_move(&check, (Move)entry->moves[i]);
+    }
+    return memcmp(&check, cube, sizeof(CubieCube)) == 0 ? entry : NULL;
+}
+
+// Цена ходов по таблице move_cost, без таблицы - просто их число
+static int sequence_cost(const unsigned char* move_cost, const Move* moves, int count) {
+    if (!move_cost) return count;
+    int cost = 0;
+    for (int i = 0; i < count; i++) {
+        cost += move_cost[moves[i]];
+    }
+    return cost;
+}
+
+int move_optimizer_window(Move* moves, int count, const unsigned char* move_cost) {
+    move_optimizer_init();
+
+    bool changed = true;
+    while (changed) {
+        changed = false;
+
+        for (int start = 0; start < count && !changed; start++) {
+            CubieCube net;
+            cubie_cube_init_solved(&net);
+
+            int best_length = 0;
+            int best_gain = 0;
+            const WindowEntry* best = NULL;
+            for (int length = 1; length <= MOVE_OPTIMIZER_WINDOW && start + length <= count; length++) {
+                if (moves[start + length - 1] >= MOVE_COUNT) break;
+                cubie_cube_apply_move(&net, moves[start + length - 1]);
+                if (length <= 1) continue;
+
+                const WindowEntry* entry = lookup(&net);
+                if (!entry) continue;
+
+                Move replacement[MOVE_OPTIMIZER_TABLE_DEPTH];
+                for (int i = 0; i < entry->length; i++) {
+                    replacement[i] = (Move)entry->moves[i];
+                }
+                int gain = sequence_cost(move_cost, &moves[start], length) -
+                           sequence_cost(move_cost, replacement, entry->length);
+                if (gain > best_gain) {
+                    best = entry;
+                    best_length = length;
+                    best_gain = gain;
+                }
+            }
+
+            if (best) {
+                memmove(&moves[start + best->length], &moves[start + best_length],
+                        (count - start - best_length) * sizeof(Move));
+                for (int i = 0; i < best->length; i++) {
+                    moves[start + i] = (Move)best->moves[i];
+                }
+                count = move_optimizer_merge(moves, count - best_length + best->length);
+                changed = true;
+            }
+        }
+    }
+    return count;
+}
@@ -0,0 +1,29 @@
+#ifndef MOVE_OPTIMIZER_H
+#define MOVE_OPTIMIZER_H
+
+#include <stdbool.h>
+#include "cube_solver.h"
+
+// Окно, которое пытаемся заменить более короткой последовательностью из таблицы
+#define MOVE_OPTIMIZER_WINDOW 10
+// Глубина таблицы замен (все последовательности до 4 ходов)
+#define MOVE_OPTIMIZER_TABLE_DEPTH 4
+
+/*
+    Merges same-face moves, also across an opposite face (R L R' -> L),
+    and puts commuting opposite-face pairs into a fixed order (U before D,
+    F before B, R before L). Works in place, returns the new move count.
+    Slices, wide moves and rotations are kept as they are and stop merging.
+*/
+int move_optimizer_merge(Move* moves, int count);
+// Same, when moves[0..merged) is already a merge result: only moves[merged..count) are pushed onto it
+int move_optimizer_merge_onto(Move* moves, int merged, int count);
+
+// Builds the replacement table now instead of inside the first move_optimizer_window call
+void move_optimizer_init(void);
+
+// Replaces windows whose net effect has a cheaper equivalent in the table; in place.
+// move_cost is indexed by Move; NULL counts every move as 1
+int move_optimizer_window(Move* moves, int count, const unsigned char* move_cost);
+
+#endif /* MOVE_OPTIMIZER_H */
@@ -0,0 +1,367 @@
+/* Auto-generated by tools/gen_move_tables.c - DO NOT EDIT */
+
+#ifndef MOVE_TABLES_H
+#define MOVE_TABLES_H
+
+#include "cube_solver.h"
+
+#define MOVE_TABLES_FACELETS 54
+#define MOVE_TABLES_ROTATIONS 24
+#define MOVE_TABLES_MOVED 20
+
+// Geometry the tables come from: outward normal, column axis, row axis of each face (x right, y up, z front)
+static const signed char cube_face_axes[6][3][3] = {
+    {{0, 1, 0}, {1, 0, 0}, {0, 0, -1}}, // FACE_IDX_TOP
+    {{0, 0, 1}, {1, 0, 0}, {0, -1, 0}}, // FACE_IDX_FRONT
+    {{1, 0, 0}, {0, 0, 1}, {0, -1, 0}}, // FACE_IDX_RIGHT
+    {{0, 0, -1}, {-1, 0, 0}, {0, -1, 0}}, // FACE_IDX_BACK
+    {{-1, 0, 0}, {0, 0, -1}, {0, -1, 0}}, // FACE_IDX_LEFT
+    {{0, -1, 0}, {1, 0, 0}, {0, 0, 1}}, // FACE_IDX_BOTTOM
+};
+
+// After move m, facelet i (face * 9 + pos) holds what was at facelet_move_src[m][i]
+static const unsigned char facelet_move_src[MOVE_EXTENDED_COUNT][MOVE_TABLES_FACELETS] = {
+    {2, 5, 8, 1, 4, 7, 0, 3, 6, 20, 19, 18, 12, 13, 14, 15, 16, 17, 29, 28, 27, 21, 22, 23, 24, 25, 26, 38, 37, 36, 30, 31, 32, 33, 34, 35, 11, 10, 9, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {6, 3, 0, 7, 4, 1, 8, 5, 2, 38, 37, 36, 12, 13, 14, 15, 16, 17, 11, 10, 9, 21, 22, 23, 24, 25, 26, 20, 19, 18, 30, 31, 32, 33, 34, 35, 29, 28, 27, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {8, 7, 6, 5, 4, 3, 2, 1, 0, 27, 28, 29, 12, 13, 14, 15, 16, 17, 36, 37, 38, 21, 22, 23, 24, 25, 26, 9, 10, 11, 30, 31, 32, 33, 34, 35, 18, 19, 20, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 44, 43, 42, 18, 19, 20, 21, 22, 23, 17, 16, 15, 27, 28, 29, 30, 31, 32, 26, 25, 24, 36, 37, 38, 39, 40, 41, 35, 34, 33, 47, 50, 53, 46, 49, 52, 45, 48, 51},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 26, 25, 24, 18, 19, 20, 21, 22, 23, 35, 34, 33, 27, 28, 29, 30, 31, 32, 44, 43, 42, 36, 37, 38, 39, 40, 41, 17, 16, 15, 51, 48, 45, 52, 49, 46, 53, 50, 47},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 33, 34, 35, 18, 19, 20, 21, 22, 23, 42, 43, 44, 27, 28, 29, 30, 31, 32, 15, 16, 17, 36, 37, 38, 39, 40, 41, 24, 25, 26, 53, 52, 51, 50, 49, 48, 47, 46, 45},
+    {42, 39, 36, 3, 4, 5, 6, 7, 8, 15, 12, 9, 16, 13, 10, 17, 14, 11, 18, 19, 0, 21, 22, 1, 24, 25, 2, 27, 28, 29, 30, 31, 32, 33, 34, 35, 51, 37, 38, 52, 40, 41, 53, 43, 44, 45, 46, 47, 48, 49, 50, 26, 23, 20},
+    {20, 23, 26, 3, 4, 5, 6, 7, 8, 11, 14, 17, 10, 13, 16, 9, 12, 15, 18, 19, 53, 21, 22, 52, 24, 25, 51, 27, 28, 29, 30, 31, 32, 33, 34, 35, 2, 37, 38, 1, 40, 41, 0, 43, 44, 45, 46, 47, 48, 49, 50, 36, 39, 42},
+    {53, 52, 51, 3, 4, 5, 6, 7, 8, 17, 16, 15, 14, 13, 12, 11, 10, 9, 18, 19, 42, 21, 22, 39, 24, 25, 36, 27, 28, 29, 30, 31, 32, 33, 34, 35, 26, 37, 38, 23, 40, 41, 20, 43, 44, 45, 46, 47, 48, 49, 50, 2, 1, 0},
+    {0, 1, 2, 3, 4, 5, 18, 21, 24, 9, 10, 11, 12, 13, 14, 15, 16, 17, 47, 19, 20, 46, 22, 23, 45, 25, 26, 33, 30, 27, 34, 31, 28, 35, 32, 29, 36, 37, 8, 39, 40, 7, 42, 43, 6, 38, 41, 44, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 3, 4, 5, 44, 41, 38, 9, 10, 11, 12, 13, 14, 15, 16, 17, 6, 19, 20, 7, 22, 23, 8, 25, 26, 29, 32, 35, 28, 31, 34, 27, 30, 33, 36, 37, 45, 39, 40, 46, 42, 43, 47, 24, 21, 18, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 3, 4, 5, 47, 46, 45, 9, 10, 11, 12, 13, 14, 15, 16, 17, 44, 19, 20, 41, 22, 23, 38, 25, 26, 35, 34, 33, 32, 31, 30, 29, 28, 27, 36, 37, 24, 39, 40, 21, 42, 43, 18, 8, 7, 6, 48, 49, 50, 51, 52, 53},
+    {0, 1, 17, 3, 4, 14, 6, 7, 11, 9, 10, 53, 12, 13, 50, 15, 16, 47, 20, 23, 26, 19, 22, 25, 18, 21, 24, 2, 28, 29, 5, 31, 32, 8, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 27, 48, 49, 30, 51, 52, 33},
+    {0, 1, 27, 3, 4, 30, 6, 7, 33, 9, 10, 8, 12, 13, 5, 15, 16, 2, 24, 21, 18, 25, 22, 19, 26, 23, 20, 47, 28, 29, 50, 31, 32, 53, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 17, 48, 49, 14, 51, 52, 11},
+    {0, 1, 47, 3, 4, 50, 6, 7, 53, 9, 10, 33, 12, 13, 30, 15, 16, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 28, 29, 14, 31, 32, 11, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 2, 48, 49, 5, 51, 52, 8},
+    {29, 1, 2, 32, 4, 5, 35, 7, 8, 6, 10, 11, 3, 13, 14, 0, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 45, 30, 31, 48, 33, 34, 51, 38, 41, 44, 37, 40, 43, 36, 39, 42, 15, 46, 47, 12, 49, 50, 9, 52, 53},
+    {15, 1, 2, 12, 4, 5, 9, 7, 8, 51, 10, 11, 48, 13, 14, 45, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 0, 30, 31, 3, 33, 34, 6, 42, 39, 36, 43, 40, 37, 44, 41, 38, 29, 46, 47, 32, 49, 50, 35, 52, 53},
+    {45, 1, 2, 48, 4, 5, 51, 7, 8, 35, 10, 11, 32, 13, 14, 29, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 15, 30, 31, 12, 33, 34, 9, 44, 43, 42, 41, 40, 39, 38, 37, 36, 0, 46, 47, 3, 49, 50, 6, 52, 53},
+    {0, 28, 2, 3, 31, 5, 6, 34, 8, 9, 7, 11, 12, 4, 14, 15, 1, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 46, 29, 30, 49, 32, 33, 52, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 16, 47, 48, 13, 50, 51, 10, 53},
+    {0, 16, 2, 3, 13, 5, 6, 10, 8, 9, 52, 11, 12, 49, 14, 15, 46, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 1, 29, 30, 4, 32, 33, 7, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 28, 47, 48, 31, 50, 51, 34, 53},
+    {0, 46, 2, 3, 49, 5, 6, 52, 8, 9, 34, 11, 12, 31, 14, 15, 28, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 16, 29, 30, 13, 32, 33, 10, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 1, 47, 48, 4, 50, 51, 7, 53},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 41, 40, 39, 15, 16, 17, 18, 19, 20, 14, 13, 12, 24, 25, 26, 27, 28, 29, 23, 22, 21, 33, 34, 35, 36, 37, 38, 32, 31, 30, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 23, 22, 21, 15, 16, 17, 18, 19, 20, 32, 31, 30, 24, 25, 26, 27, 28, 29, 41, 40, 39, 33, 34, 35, 36, 37, 38, 14, 13, 12, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 30, 31, 32, 15, 16, 17, 18, 19, 20, 39, 40, 41, 24, 25, 26, 27, 28, 29, 12, 13, 14, 33, 34, 35, 36, 37, 38, 21, 22, 23, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 43, 40, 37, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 3, 20, 21, 4, 23, 24, 5, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 48, 38, 39, 49, 41, 42, 50, 44, 45, 46, 47, 25, 22, 19, 51, 52, 53},
+    {0, 1, 2, 19, 22, 25, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 50, 20, 21, 49, 23, 24, 48, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 5, 38, 39, 4, 41, 42, 3, 44, 45, 46, 47, 37, 40, 43, 51, 52, 53},
+    {0, 1, 2, 50, 49, 48, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 43, 20, 21, 40, 23, 24, 37, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 25, 38, 39, 22, 41, 42, 19, 44, 45, 46, 47, 5, 4, 3, 51, 52, 53},
+    {2, 5, 8, 1, 4, 7, 0, 3, 6, 20, 19, 18, 23, 22, 21, 15, 16, 17, 29, 28, 27, 32, 31, 30, 24, 25, 26, 38, 37, 36, 41, 40, 39, 33, 34, 35, 11, 10, 9, 14, 13, 12, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {6, 3, 0, 7, 4, 1, 8, 5, 2, 38, 37, 36, 41, 40, 39, 15, 16, 17, 11, 10, 9, 14, 13, 12, 24, 25, 26, 20, 19, 18, 23, 22, 21, 33, 34, 35, 29, 28, 27, 32, 31, 30, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {8, 7, 6, 5, 4, 3, 2, 1, 0, 27, 28, 29, 30, 31, 32, 15, 16, 17, 36, 37, 38, 39, 40, 41, 24, 25, 26, 9, 10, 11, 12, 13, 14, 33, 34, 35, 18, 19, 20, 21, 22, 23, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 41, 40, 39, 44, 43, 42, 18, 19, 20, 14, 13, 12, 17, 16, 15, 27, 28, 29, 23, 22, 21, 26, 25, 24, 36, 37, 38, 32, 31, 30, 35, 34, 33, 47, 50, 53, 46, 49, 52, 45, 48, 51},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 23, 22, 21, 26, 25, 24, 18, 19, 20, 32, 31, 30, 35, 34, 33, 27, 28, 29, 41, 40, 39, 44, 43, 42, 36, 37, 38, 14, 13, 12, 17, 16, 15, 51, 48, 45, 52, 49, 46, 53, 50, 47},
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 30, 31, 32, 33, 34, 35, 18, 19, 20, 39, 40, 41, 42, 43, 44, 27, 28, 29, 12, 13, 14, 15, 16, 17, 36, 37, 38, 21, 22, 23, 24, 25, 26, 53, 52, 51, 50, 49, 48, 47, 46, 45},
+    {42, 39, 36, 43, 40, 37, 6, 7, 8, 15, 12, 9, 16, 13, 10, 17, 14, 11, 18, 3, 0, 21, 4, 1, 24, 5, 2, 27, 28, 29, 30, 31, 32, 33, 34, 35, 51, 48, 38, 52, 49, 41, 53, 50, 44, 45, 46, 47, 25, 22, 19, 26, 23, 20},
+    {20, 23, 26, 19, 22, 25, 6, 7, 8, 11, 14, 17, 10, 13, 16, 9, 12, 15, 18, 50, 53, 21, 49, 52, 24, 48, 51, 27, 28, 29, 30, 31, 32, 33, 34, 35, 2, 5, 38, 1, 4, 41, 0, 3, 44, 45, 46, 47, 37, 40, 43, 36, 39, 42},
+    {53, 52, 51, 50, 49, 48, 6, 7, 8, 17, 16, 15, 14, 13, 12, 11, 10, 9, 18, 43, 42, 21, 40, 39, 24, 37, 36, 27, 28, 29, 30, 31, 32, 33, 34, 35, 26, 25, 38, 23, 22, 41, 20, 19, 44, 45, 46, 47, 5, 4, 3, 2, 1, 0},
+    {0, 1, 2, 19, 22, 25, 18, 21, 24, 9, 10, 11, 12, 13, 14, 15, 16, 17, 47, 50, 20, 46, 49, 23, 45, 48, 26, 33, 30, 27, 34, 31, 28, 35, 32, 29, 36, 5, 8, 39, 4, 7, 42, 3, 6, 38, 41, 44, 37, 40, 43, 51, 52, 53},
+    {0, 1, 2, 43, 40, 37, 44, 41, 38, 9, 10, 11, 12, 13, 14, 15, 16, 17, 6, 3, 20, 7, 4, 23, 8, 5, 26, 29, 32, 35, 28, 31, 34, 27, 30, 33, 36, 48, 45, 39, 49, 46, 42, 50, 47, 24, 21, 18, 25, 22, 19, 51, 52, 53},
+    {0, 1, 2, 50, 49, 48, 47, 46, 45, 9, 10, 11, 12, 13, 14, 15, 16, 17, 44, 43, 20, 41, 40, 23, 38, 37, 26, 35, 34, 33, 32, 31, 30, 29, 28, 27, 36, 25, 24, 39, 22, 21, 42, 19, 18, 8, 7, 6, 5, 4, 3, 51, 52, 53},
+    {0, 16, 17, 3, 13, 14, 6, 10, 11, 9, 52, 53, 12, 49, 50, 15, 46, 47, 20, 23, 26, 19, 22, 25, 18, 21, 24, 2, 1, 29, 5, 4, 32, 8, 7, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 28, 27, 48, 31, 30, 51, 34, 33},
+    {0, 28, 27, 3, 31, 30, 6, 34, 33, 9, 7, 8, 12, 4, 5, 15, 1, 2, 24, 21, 18, 25, 22, 19, 26, 23, 20, 47, 46, 29, 50, 49, 32, 53, 52, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 16, 17, 48, 13, 14, 51, 10, 11},
+    {0, 46, 47, 3, 49, 50, 6, 52, 53, 9, 34, 33, 12, 31, 30, 15, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 29, 14, 13, 32, 11, 10, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 1, 2, 48, 4, 5, 51, 7, 8},
+    {29, 28, 2, 32, 31, 5, 35, 34, 8, 6, 7, 11, 3, 4, 14, 0, 1, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 46, 45, 30, 49, 48, 33, 52, 51, 38, 41, 44, 37, 40, 43, 36, 39, 42, 15, 16, 47, 12, 13, 50, 9, 10, 53},
+    {15, 16, 2, 12, 13, 5, 9, 10, 8, 51, 52, 11, 48, 49, 14, 45, 46, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 1, 0, 30, 4, 3, 33, 7, 6, 42, 39, 36, 43, 40, 37, 44, 41, 38, 29, 28, 47, 32, 31, 50, 35, 34, 53},
+    {45, 46, 2, 48, 49, 5, 51, 52, 8, 35, 34, 11, 32, 31, 14, 29, 28, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 16, 15, 30, 13, 12, 33, 10, 9, 44, 43, 42, 41, 40, 39, 38, 37, 36, 0, 1, 47, 3, 4, 50, 6, 7, 53},
+    {15, 16, 17, 12, 13, 14, 9, 10, 11, 51, 52, 53, 48, 49, 50, 45, 46, 47, 20, 23, 26, 19, 22, 25, 18, 21, 24, 2, 1, 0, 5, 4, 3, 8, 7, 6, 42, 39, 36, 43, 40, 37, 44, 41, 38, 29, 28, 27, 32, 31, 30, 35, 34, 33},
+    {29, 28, 27, 32, 31, 30, 35, 34, 33, 6, 7, 8, 3, 4, 5, 0, 1, 2, 24, 21, 18, 25, 22, 19, 26, 23, 20, 47, 46, 45, 50, 49, 48, 53, 52, 51, 38, 41, 44, 37, 40, 43, 36, 39, 42, 15, 16, 17, 12, 13, 14, 9, 10, 11},
+    {45, 46, 47, 48, 49, 50, 51, 52, 53, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 44, 43, 42, 41, 40, 39, 38, 37, 36, 0, 1, 2, 3, 4, 5, 6, 7, 8},
+    {2, 5, 8, 1, 4, 7, 0, 3, 6, 20, 19, 18, 23, 22, 21, 26, 25, 24, 29, 28, 27, 32, 31, 30, 35, 34, 33, 38, 37, 36, 41, 40, 39, 44, 43, 42, 11, 10, 9, 14, 13, 12, 17, 16, 15, 51, 48, 45, 52, 49, 46, 53, 50, 47},
+    {6, 3, 0, 7, 4, 1, 8, 5, 2, 38, 37, 36, 41, 40, 39, 44, 43, 42, 11, 10, 9, 14, 13, 12, 17, 16, 15, 20, 19, 18, 23, 22, 21, 26, 25, 24, 29, 28, 27, 32, 31, 30, 35, 34, 33, 47, 50, 53, 46, 49, 52, 45, 48, 51},
+    {8, 7, 6, 5, 4, 3, 2, 1, 0, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 53, 52, 51, 50, 49, 48, 47, 46, 45},
+    {42, 39, 36, 43, 40, 37, 44, 41, 38, 15, 12, 9, 16, 13, 10, 17, 14, 11, 6, 3, 0, 7, 4, 1, 8, 5, 2, 29, 32, 35, 28, 31, 34, 27, 30, 33, 51, 48, 45, 52, 49, 46, 53, 50, 47, 24, 21, 18, 25, 22, 19, 26, 23, 20},
+    {20, 23, 26, 19, 22, 25, 18, 21, 24, 11, 14, 17, 10, 13, 16, 9, 12, 15, 47, 50, 53, 46, 49, 52, 45, 48, 51, 33, 30, 27, 34, 31, 28, 35, 32, 29, 2, 5, 8, 1, 4, 7, 0, 3, 6, 38, 41, 44, 37, 40, 43, 36, 39, 42},
+    {53, 52, 51, 50, 49, 48, 47, 46, 45, 17, 16, 15, 14, 13, 12, 11, 10, 9, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 8, 7, 6, 5, 4, 3, 2, 1, 0},
+};
+
+// For face turns: the same permutation restricted to the facelets the move changes, as {facelet, src} pairs
+static const unsigned char facelet_move_moved[MOVE_COUNT][MOVE_TABLES_MOVED][2] = {
+    {{0, 2}, {1, 5}, {2, 8}, {3, 1}, {5, 7}, {6, 0}, {7, 3}, {8, 6}, {9, 20}, {10, 19}, {11, 18}, {18, 29}, {19, 28}, {20, 27}, {27, 38}, {28, 37}, {29, 36}, {36, 11}, {37, 10}, {38, 9}},
+    {{0, 6}, {1, 3}, {2, 0}, {3, 7}, {5, 1}, {6, 8}, {7, 5}, {8, 2}, {9, 38}, {10, 37}, {11, 36}, {18, 11}, {19, 10}, {20, 9}, {27, 20}, {28, 19}, {29, 18}, {36, 29}, {37, 28}, {38, 27}},
+    {{0, 8}, {1, 7}, {2, 6}, {3, 5}, {5, 3}, {6, 2}, {7, 1}, {8, 0}, {9, 27}, {10, 28}, {11, 29}, {18, 36}, {19, 37}, {20, 38}, {27, 9}, {28, 10}, {29, 11}, {36, 18}, {37, 19}, {38, 20}},
+    {{15, 44}, {16, 43}, {17, 42}, {24, 17}, {25, 16}, {26, 15}, {33, 26}, {34, 25}, {35, 24}, {42, 35}, {43, 34}, {44, 33}, {45, 47}, {46, 50}, {47, 53}, {48, 46}, {50, 52}, {51, 45}, {52, 48}, {53, 51}},
+    {{15, 26}, {16, 25}, {17, 24}, {24, 35}, {25, 34}, {26, 33}, {33, 44}, {34, 43}, {35, 42}, {42, 17}, {43, 16}, {44, 15}, {45, 51}, {46, 48}, {47, 45}, {48, 52}, {50, 46}, {51, 53}, {52, 50}, {53, 47}},
+    {{15, 33}, {16, 34}, {17, 35}, {24, 42}, {25, 43}, {26, 44}, {33, 15}, {34, 16}, {35, 17}, {42, 24}, {43, 25}, {44, 26}, {45, 53}, {46, 52}, {47, 51}, {48, 50}, {50, 48}, {51, 47}, {52, 46}, {53, 45}},
+    {{0, 42}, {1, 39}, {2, 36}, {9, 15}, {10, 12}, {11, 9}, {12, 16}, {14, 10}, {15, 17}, {16, 14}, {17, 11}, {20, 0}, {23, 1}, {26, 2}, {36, 51}, {39, 52}, {42, 53}, {51, 26}, {52, 23}, {53, 20}},
+    {{0, 20}, {1, 23}, {2, 26}, {9, 11}, {10, 14}, {11, 17}, {12, 10}, {14, 16}, {15, 9}, {16, 12}, {17, 15}, {20, 53}, {23, 52}, {26, 51}, {36, 2}, {39, 1}, {42, 0}, {51, 36}, {52, 39}, {53, 42}},
+    {{0, 53}, {1, 52}, {2, 51}, {9, 17}, {10, 16}, {11, 15}, {12, 14}, {14, 12}, {15, 11}, {16, 10}, {17, 9}, {20, 42}, {23, 39}, {26, 36}, {36, 26}, {39, 23}, {42, 20}, {51, 2}, {52, 1}, {53, 0}},
+    {{6, 18}, {7, 21}, {8, 24}, {18, 47}, {21, 46}, {24, 45}, {27, 33}, {28, 30}, {29, 27}, {30, 34}, {32, 28}, {33, 35}, {34, 32}, {35, 29}, {38, 8}, {41, 7}, {44, 6}, {45, 38}, {46, 41}, {47, 44}},
+    {{6, 44}, {7, 41}, {8, 38}, {18, 6}, {21, 7}, {24, 8}, {27, 29}, {28, 32}, {29, 35}, {30, 28}, {32, 34}, {33, 27}, {34, 30}, {35, 33}, {38, 45}, {41, 46}, {44, 47}, {45, 24}, {46, 21}, {47, 18}},
+    {{6, 47}, {7, 46}, {8, 45}, {18, 44}, {21, 41}, {24, 38}, {27, 35}, {28, 34}, {29, 33}, {30, 32}, {32, 30}, {33, 29}, {34, 28}, {35, 27}, {38, 24}, {41, 21}, {44, 18}, {45, 8}, {46, 7}, {47, 6}},
+    {{2, 17}, {5, 14}, {8, 11}, {11, 53}, {14, 50}, {17, 47}, {18, 20}, {19, 23}, {20, 26}, {21, 19}, {23, 25}, {24, 18}, {25, 21}, {26, 24}, {27, 2}, {30, 5}, {33, 8}, {47, 27}, {50, 30}, {53, 33}},
+    {{2, 27}, {5, 30}, {8, 33}, {11, 8}, {14, 5}, {17, 2}, {18, 24}, {19, 21}, {20, 18}, {21, 25}, {23, 19}, {24, 26}, {25, 23}, {26, 20}, {27, 47}, {30, 50}, {33, 53}, {47, 17}, {50, 14}, {53, 11}},
+    {{2, 47}, {5, 50}, {8, 53}, {11, 33}, {14, 30}, {17, 27}, {18, 26}, {19, 25}, {20, 24}, {21, 23}, {23, 21}, {24, 20}, {25, 19}, {26, 18}, {27, 17}, {30, 14}, {33, 11}, {47, 2}, {50, 5}, {53, 8}},
+    {{0, 29}, {3, 32}, {6, 35}, {9, 6}, {12, 3}, {15, 0}, {29, 45}, {32, 48}, {35, 51}, {36, 38}, {37, 41}, {38, 44}, {39, 37}, {41, 43}, {42, 36}, {43, 39}, {44, 42}, {45, 15}, {48, 12}, {51, 9}},
+    {{0, 15}, {3, 12}, {6, 9}, {9, 51}, {12, 48}, {15, 45}, {29, 0}, {32, 3}, {35, 6}, {36, 42}, {37, 39}, {38, 36}, {39, 43}, {41, 37}, {42, 44}, {43, 41}, {44, 38}, {45, 29}, {48, 32}, {51, 35}},
+    {{0, 45}, {3, 48}, {6, 51}, {9, 35}, {12, 32}, {15, 29}, {29, 15}, {32, 12}, {35, 9}, {36, 44}, {37, 43}, {38, 42}, {39, 41}, {41, 39}, {42, 38}, {43, 37}, {44, 36}, {45, 0}, {48, 3}, {51, 6}},
+};
+
+// Facelet positions of each corner / edge, sticker 0 always on U or D for corners
+static const unsigned char cubie_corner_facelets[8][3][2] = {
+    {{FACE_IDX_TOP, 0}, {FACE_IDX_FRONT, 0}, {FACE_IDX_LEFT, 0}}, // UFL
+    {{FACE_IDX_TOP, 2}, {FACE_IDX_RIGHT, 2}, {FACE_IDX_FRONT, 2}}, // URF
+    {{FACE_IDX_TOP, 6}, {FACE_IDX_LEFT, 2}, {FACE_IDX_BACK, 2}}, // ULB
+    {{FACE_IDX_TOP, 8}, {FACE_IDX_BACK, 0}, {FACE_IDX_RIGHT, 0}}, // UBR
+    {{FACE_IDX_BOTTOM, 0}, {FACE_IDX_BACK, 8}, {FACE_IDX_LEFT, 8}}, // DBL
+    {{FACE_IDX_BOTTOM, 2}, {FACE_IDX_RIGHT, 6}, {FACE_IDX_BACK, 6}}, // DRB
+    {{FACE_IDX_BOTTOM, 6}, {FACE_IDX_LEFT, 6}, {FACE_IDX_FRONT, 6}}, // DLF
+    {{FACE_IDX_BOTTOM, 8}, {FACE_IDX_FRONT, 8}, {FACE_IDX_RIGHT, 8}}, // DFR
+};
+
+static const unsigned char cubie_edge_facelets[12][2][2] = {
+    {{FACE_IDX_TOP, 1}, {FACE_IDX_FRONT, 1}}, // UF
+    {{FACE_IDX_TOP, 3}, {FACE_IDX_LEFT, 1}}, // UL
+    {{FACE_IDX_TOP, 5}, {FACE_IDX_RIGHT, 1}}, // UR
+    {{FACE_IDX_TOP, 7}, {FACE_IDX_BACK, 1}}, // UB
+    {{FACE_IDX_BOTTOM, 1}, {FACE_IDX_BACK, 7}}, // DB
+    {{FACE_IDX_BOTTOM, 3}, {FACE_IDX_LEFT, 7}}, // DL
+    {{FACE_IDX_BOTTOM, 5}, {FACE_IDX_RIGHT, 7}}, // DR
+    {{FACE_IDX_BOTTOM, 7}, {FACE_IDX_FRONT, 7}}, // DF
+    {{FACE_IDX_FRONT, 3}, {FACE_IDX_LEFT, 3}}, // FL
+    {{FACE_IDX_FRONT, 5}, {FACE_IDX_RIGHT, 5}}, // FR
+    {{FACE_IDX_BACK, 5}, {FACE_IDX_LEFT, 5}}, // BL
+    {{FACE_IDX_BACK, 3}, {FACE_IDX_RIGHT, 3}}, // BR
+};
+
+// After move m, position i holds the piece from src[m][i], twisted / flipped by the delta
+static const unsigned char cubie_corner_move_src[MOVE_COUNT][8] = {
+    {1, 3, 0, 2, 4, 5, 6, 7},
+    {2, 0, 3, 1, 4, 5, 6, 7},
+    {3, 2, 1, 0, 4, 5, 6, 7},
+    {0, 1, 2, 3, 5, 7, 4, 6},
+    {0, 1, 2, 3, 6, 4, 7, 5},
+    {0, 1, 2, 3, 7, 6, 5, 4},
+    {6, 0, 2, 3, 4, 5, 7, 1},
+    {1, 7, 2, 3, 4, 5, 0, 6},
+    {7, 6, 2, 3, 4, 5, 1, 0},
+    {0, 1, 3, 5, 2, 4, 6, 7},
+    {0, 1, 4, 2, 5, 3, 6, 7},
+    {0, 1, 5, 4, 3, 2, 6, 7},
+    {0, 7, 2, 1, 4, 3, 6, 5},
+    {0, 3, 2, 5, 4, 7, 6, 1},
+    {0, 5, 2, 7, 4, 1, 6, 3},
+    {2, 1, 4, 3, 6, 5, 0, 7},
+    {6, 1, 0, 3, 2, 5, 4, 7},
+    {4, 1, 6, 3, 0, 5, 2, 7},
+};
+
+static const unsigned char cubie_corner_move_twist[MOVE_COUNT][8] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {2, 1, 0, 0, 0, 0, 1, 2},
+    {2, 1, 0, 0, 0, 0, 1, 2},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 1, 2, 2, 1, 0, 0},
+    {0, 0, 1, 2, 2, 1, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 2, 0, 1, 0, 2, 0, 1},
+    {0, 2, 0, 1, 0, 2, 0, 1},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 0, 2, 0, 1, 0, 2, 0},
+    {1, 0, 2, 0, 1, 0, 2, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+};
+
+static const unsigned char cubie_edge_move_src[MOVE_COUNT][12] = {
+    {2, 0, 3, 1, 4, 5, 6, 7, 8, 9, 10, 11},
+    {1, 3, 0, 2, 4, 5, 6, 7, 8, 9, 10, 11},
+    {3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11},
+    {0, 1, 2, 3, 6, 4, 7, 5, 8, 9, 10, 11},
+    {0, 1, 2, 3, 5, 7, 4, 6, 8, 9, 10, 11},
+    {0, 1, 2, 3, 7, 6, 5, 4, 8, 9, 10, 11},
+    {8, 1, 2, 3, 4, 5, 6, 9, 7, 0, 10, 11},
+    {9, 1, 2, 3, 4, 5, 6, 8, 0, 7, 10, 11},
+    {7, 1, 2, 3, 4, 5, 6, 0, 9, 8, 10, 11},
+    {0, 1, 2, 11, 10, 5, 6, 7, 8, 9, 3, 4},
+    {0, 1, 2, 10, 11, 5, 6, 7, 8, 9, 4, 3},
+    {0, 1, 2, 4, 3, 5, 6, 7, 8, 9, 11, 10},
+    {0, 1, 9, 3, 4, 5, 11, 7, 8, 6, 10, 2},
+    {0, 1, 11, 3, 4, 5, 9, 7, 8, 2, 10, 6},
+    {0, 1, 6, 3, 4, 5, 2, 7, 8, 11, 10, 9},
+    {0, 10, 2, 3, 4, 8, 6, 7, 1, 9, 5, 11},
+    {0, 8, 2, 3, 4, 10, 6, 7, 5, 9, 1, 11},
+    {0, 5, 2, 3, 4, 1, 6, 7, 10, 9, 8, 11},
+};
+
+static const unsigned char cubie_edge_move_flip[MOVE_COUNT][12] = {
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0},
+    {1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1},
+    {0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+};
+
+// Inverse tables: move m takes the piece at position p to dest[m][p]
+static const unsigned char cubie_corner_move_to[MOVE_COUNT][8] = {
+    {2, 0, 3, 1, 4, 5, 6, 7},
+    {1, 3, 0, 2, 4, 5, 6, 7},
+    {3, 2, 1, 0, 4, 5, 6, 7},
+    {0, 1, 2, 3, 6, 4, 7, 5},
+    {0, 1, 2, 3, 5, 7, 4, 6},
+    {0, 1, 2, 3, 7, 6, 5, 4},
+    {1, 7, 2, 3, 4, 5, 0, 6},
+    {6, 0, 2, 3, 4, 5, 7, 1},
+    {7, 6, 2, 3, 4, 5, 1, 0},
+    {0, 1, 4, 2, 5, 3, 6, 7},
+    {0, 1, 3, 5, 2, 4, 6, 7},
+    {0, 1, 5, 4, 3, 2, 6, 7},
+    {0, 3, 2, 5, 4, 7, 6, 1},
+    {0, 7, 2, 1, 4, 3, 6, 5},
+    {0, 5, 2, 7, 4, 1, 6, 3},
+    {6, 1, 0, 3, 2, 5, 4, 7},
+    {2, 1, 4, 3, 6, 5, 0, 7},
+    {4, 1, 6, 3, 0, 5, 2, 7},
+};
+
+static const unsigned char cubie_corner_move_to_twist[MOVE_COUNT][8] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 2, 0, 0, 0, 0, 2, 1},
+    {1, 2, 0, 0, 0, 0, 2, 1},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 2, 1, 1, 2, 0, 0},
+    {0, 0, 2, 1, 1, 2, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 1, 0, 2, 0, 1, 0, 2},
+    {0, 1, 0, 2, 0, 1, 0, 2},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {2, 0, 1, 0, 2, 0, 1, 0},
+    {2, 0, 1, 0, 2, 0, 1, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0},
+};
+
+static const unsigned char cubie_edge_move_to[MOVE_COUNT][12] = {
+    {1, 3, 0, 2, 4, 5, 6, 7, 8, 9, 10, 11},
+    {2, 0, 3, 1, 4, 5, 6, 7, 8, 9, 10, 11},
+    {3, 2, 1, 0, 4, 5, 6, 7, 8, 9, 10, 11},
+    {0, 1, 2, 3, 5, 7, 4, 6, 8, 9, 10, 11},
+    {0, 1, 2, 3, 6, 4, 7, 5, 8, 9, 10, 11},
+    {0, 1, 2, 3, 7, 6, 5, 4, 8, 9, 10, 11},
+    {9, 1, 2, 3, 4, 5, 6, 8, 0, 7, 10, 11},
+    {8, 1, 2, 3, 4, 5, 6, 9, 7, 0, 10, 11},
+    {7, 1, 2, 3, 4, 5, 6, 0, 9, 8, 10, 11},
+    {0, 1, 2, 10, 11, 5, 6, 7, 8, 9, 4, 3},
+    {0, 1, 2, 11, 10, 5, 6, 7, 8, 9, 3, 4},
+    {0, 1, 2, 4, 3, 5, 6, 7, 8, 9, 11, 10},
+    {0, 1, 11, 3, 4, 5, 9, 7, 8, 2, 10, 6},
+    {0, 1, 9, 3, 4, 5, 11, 7, 8, 6, 10, 2},
+    {0, 1, 6, 3, 4, 5, 2, 7, 8, 11, 10, 9},
+    {0, 8, 2, 3, 4, 10, 6, 7, 5, 9, 1, 11},
+    {0, 10, 2, 3, 4, 8, 6, 7, 1, 9, 5, 11},
+    {0, 5, 2, 3, 4, 1, 6, 7, 10, 9, 8, 11},
+};
+
+static const unsigned char cubie_edge_move_to_flip[MOVE_COUNT][12] = {
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0},
+    {1, 0, 0, 0, 0, 0, 0, 1, 1, 1, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1},
+    {0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1, 1},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+};
+
+// Move that undoes m
+static const unsigned char move_inverse_table[MOVE_EXTENDED_COUNT] = {1, 0, 2, 4, 3, 5, 7, 6, 8, 10, 9, 11, 13, 12, 14, 16, 15, 17, 19, 18, 20, 22, 21, 23, 25, 24, 26, 28, 27, 29, 31, 30, 32, 34, 33, 35, 37, 36, 38, 40, 39, 41, 43, 42, 44, 46, 45, 47, 49, 48, 50, 52, 51, 53};
+
+// Face each move turns along with, its clockwise quarters and layer mask (bit 0 - that face)
+static const unsigned char move_face_table[MOVE_EXTENDED_COUNT] = {0, 0, 0, 5, 5, 5, 1, 1, 1, 3, 3, 3, 2, 2, 2, 4, 4, 4, 4, 4, 4, 5, 5, 5, 1, 1, 1, 0, 0, 0, 5, 5, 5, 1, 1, 1, 3, 3, 3, 2, 2, 2, 4, 4, 4, 2, 2, 2, 0, 0, 0, 1, 1, 1};
+
+static const unsigned char move_quarters_table[MOVE_EXTENDED_COUNT] = {1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2, 1, 3, 2};
+
+static const unsigned char move_layers_table[MOVE_EXTENDED_COUNT] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 7, 7, 7, 7, 7, 7, 7, 7, 7};
+
+static const char* const move_name_table[MOVE_EXTENDED_COUNT] = {"U", "U'", "U2", "D", "D'", "D2", "F", "F'", "F2", "B", "B'", "B2", "R", "R'", "R2", "L", "L'", "L2", "M", "M'", "M2", "E", "E'", "E2", "S", "S'", "S2", "Uw", "Uw'", "Uw2", "Dw", "Dw'", "Dw2", "Fw", "Fw'", "Fw2", "Bw", "Bw'", "Bw2", "Rw", "Rw'", "Rw2", "Lw", "Lw'", "Lw2", "x", "x'", "x2", "y", "y'", "y2", "z", "z'", "z2"};
+
+// Whole-cube rotations (identity first): facelet i takes what was at cube_rotation_src[r][i]
+static const unsigned char cube_rotation_src[MOVE_TABLES_ROTATIONS][MOVE_TABLES_FACELETS] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, 52, 53},
+    {15, 16, 17, 12, 13, 14, 9, 10, 11, 51, 52, 53, 48, 49, 50, 45, 46, 47, 20, 23, 26, 19, 22, 25, 18, 21, 24, 2, 1, 0, 5, 4, 3, 8, 7, 6, 42, 39, 36, 43, 40, 37, 44, 41, 38, 29, 28, 27, 32, 31, 30, 35, 34, 33},
+    {2, 5, 8, 1, 4, 7, 0, 3, 6, 20, 19, 18, 23, 22, 21, 26, 25, 24, 29, 28, 27, 32, 31, 30, 35, 34, 33, 38, 37, 36, 41, 40, 39, 44, 43, 42, 11, 10, 9, 14, 13, 12, 17, 16, 15, 51, 48, 45, 52, 49, 46, 53, 50, 47},
+    {45, 46, 47, 48, 49, 50, 51, 52, 53, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16, 15, 14, 13, 12, 11, 10, 9, 44, 43, 42, 41, 40, 39, 38, 37, 36, 0, 1, 2, 3, 4, 5, 6, 7, 8},
+    {17, 14, 11, 16, 13, 10, 15, 12, 9, 26, 23, 20, 25, 22, 19, 24, 21, 18, 0, 1, 2, 3, 4, 5, 6, 7, 8, 36, 39, 42, 37, 40, 43, 38, 41, 44, 53, 52, 51, 50, 49, 48, 47, 46, 45, 35, 32, 29, 34, 31, 28, 33, 30, 27},
+    {26, 25, 24, 23, 22, 21, 20, 19, 18, 53, 50, 47, 52, 49, 46, 51, 48, 45, 27, 30, 33, 28, 31, 34, 29, 32, 35, 8, 5, 2, 7, 4, 1, 6, 3, 0, 17, 14, 11, 16, 13, 10, 15, 12, 9, 36, 37, 38, 39, 40, 41, 42, 43, 44},
+    {8, 7, 6, 5, 4, 3, 2, 1, 0, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, 44, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 53, 52, 51, 50, 49, 48, 47, 46, 45},
+    {29, 28, 27, 32, 31, 30, 35, 34, 33, 6, 7, 8, 3, 4, 5, 0, 1, 2, 24, 21, 18, 25, 22, 19, 26, 23, 20, 47, 46, 45, 50, 49, 48, 53, 52, 51, 38, 41, 44, 37, 40, 43, 36, 39, 42, 15, 16, 17, 12, 13, 14, 9, 10, 11},
+    {47, 50, 53, 46, 49, 52, 45, 48, 51, 24, 25, 26, 21, 22, 23, 18, 19, 20, 15, 16, 17, 12, 13, 14, 9, 10, 11, 42, 43, 44, 39, 40, 41, 36, 37, 38, 33, 34, 35, 30, 31, 32, 27, 28, 29, 6, 3, 0, 7, 4, 1, 8, 5, 2},
+    {24, 21, 18, 25, 22, 19, 26, 23, 20, 33, 30, 27, 34, 31, 28, 35, 32, 29, 2, 5, 8, 1, 4, 7, 0, 3, 6, 11, 14, 17, 10, 13, 16, 9, 12, 15, 47, 50, 53, 46, 49, 52, 45, 48, 51, 42, 39, 36, 43, 40, 37, 44, 41, 38},
+    {11, 10, 9, 14, 13, 12, 17, 16, 15, 2, 1, 0, 5, 4, 3, 8, 7, 6, 42, 39, 36, 43, 40, 37, 44, 41, 38, 51, 52, 53, 48, 49, 50, 45, 46, 47, 20, 23, 26, 19, 22, 25, 18, 21, 24, 33, 34, 35, 30, 31, 32, 27, 28, 29},
+    {51, 48, 45, 52, 49, 46, 53, 50, 47, 42, 43, 44, 39, 40, 41, 36, 37, 38, 33, 34, 35, 30, 31, 32, 27, 28, 29, 24, 25, 26, 21, 22, 23, 18, 19, 20, 15, 16, 17, 12, 13, 14, 9, 10, 11, 2, 5, 8, 1, 4, 7, 0, 3, 6},
+    {33, 34, 35, 30, 31, 32, 27, 28, 29, 47, 46, 45, 50, 49, 48, 53, 52, 51, 38, 41, 44, 37, 40, 43, 36, 39, 42, 6, 7, 8, 3, 4, 5, 0, 1, 2, 24, 21, 18, 25, 22, 19, 26, 23, 20, 11, 10, 9, 14, 13, 12, 17, 16, 15},
+    {6, 3, 0, 7, 4, 1, 8, 5, 2, 38, 37, 36, 41, 40, 39, 44, 43, 42, 11, 10, 9, 14, 13, 12, 17, 16, 15, 20, 19, 18, 23, 22, 21, 26, 25, 24, 29, 28, 27, 32, 31, 30, 35, 34, 33, 47, 50, 53, 46, 49, 52, 45, 48, 51},
+    {27, 30, 33, 28, 31, 34, 29, 32, 35, 18, 21, 24, 19, 22, 25, 20, 23, 26, 45, 46, 47, 48, 49, 50, 51, 52, 53, 44, 41, 38, 43, 40, 37, 42, 39, 36, 8, 7, 6, 5, 4, 3, 2, 1, 0, 9, 12, 15, 10, 13, 16, 11, 14, 17},
+    {18, 19, 20, 21, 22, 23, 24, 25, 26, 8, 5, 2, 7, 4, 1, 6, 3, 0, 17, 14, 11, 16, 13, 10, 15, 12, 9, 53, 50, 47, 52, 49, 46, 51, 48, 45, 27, 30, 33, 28, 31, 34, 29, 32, 35, 44, 43, 42, 41, 40, 39, 38, 37, 36},
+    {53, 52, 51, 50, 49, 48, 47, 46, 45, 17, 16, 15, 14, 13, 12, 11, 10, 9, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32, 31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 8, 7, 6, 5, 4, 3, 2, 1, 0},
+    {35, 32, 29, 34, 31, 28, 33, 30, 27, 44, 41, 38, 43, 40, 37, 42, 39, 36, 8, 7, 6, 5, 4, 3, 2, 1, 0, 18, 21, 24, 19, 22, 25, 20, 23, 26, 45, 46, 47, 48, 49, 50, 51, 52, 53, 17, 14, 11, 16, 13, 10, 15, 12, 9},
+    {9, 12, 15, 10, 13, 16, 11, 14, 17, 36, 39, 42, 37, 40, 43, 38, 41, 44, 53, 52, 51, 50, 49, 48, 47, 46, 45, 26, 23, 20, 25, 22, 19, 24, 21, 18, 0, 1, 2, 3, 4, 5, 6, 7, 8, 27, 30, 33, 28, 31, 34, 29, 32, 35},
+    {36, 37, 38, 39, 40, 41, 42, 43, 44, 0, 3, 6, 1, 4, 7, 2, 5, 8, 35, 32, 29, 34, 31, 28, 33, 30, 27, 45, 48, 51, 46, 49, 52, 47, 50, 53, 9, 12, 15, 10, 13, 16, 11, 14, 17, 26, 25, 24, 23, 22, 21, 20, 19, 18},
+    {44, 43, 42, 41, 40, 39, 38, 37, 36, 45, 48, 51, 46, 49, 52, 47, 50, 53, 9, 12, 15, 10, 13, 16, 11, 14, 17, 0, 3, 6, 1, 4, 7, 2, 5, 8, 35, 32, 29, 34, 31, 28, 33, 30, 27, 18, 19, 20, 21, 22, 23, 24, 25, 26},
+    {20, 23, 26, 19, 22, 25, 18, 21, 24, 11, 14, 17, 10, 13, 16, 9, 12, 15, 47, 50, 53, 46, 49, 52, 45, 48, 51, 33, 30, 27, 34, 31, 28, 35, 32, 29, 2, 5, 8, 1, 4, 7, 0, 3, 6, 38, 41, 44, 37, 40, 43, 36, 39, 42},
+    {42, 39, 36, 43, 40, 37, 44, 41, 38, 15, 12, 9, 16, 13, 10, 17, 14, 11, 6, 3, 0, 7, 4, 1, 8, 5, 2, 29, 32, 35, 28, 31, 34, 27, 30, 33, 51, 48, 45, 52, 49, 46, 53, 50, 47, 24, 21, 18, 25, 22, 19, 26, 23, 20},
+    {38, 41, 44, 37, 40, 43, 36, 39, 42, 29, 32, 35, 28, 31, 34, 27, 30, 33, 51, 48, 45, 52, 49, 46, 53, 50, 47, 15, 12, 9, 16, 13, 10, 17, 14, 11, 6, 3, 0, 7, 4, 1, 8, 5, 2, 20, 23, 26, 19, 22, 25, 18, 21, 24},
+};
+
+// Face whose center the rotation brings onto face f
+static const unsigned char cube_rotation_face[MOVE_TABLES_ROTATIONS][6] = {
+    {0, 1, 2, 3, 4, 5},
+    {1, 5, 2, 0, 4, 3},
+    {0, 2, 3, 4, 1, 5},
+    {5, 3, 2, 1, 4, 0},
+    {1, 2, 0, 4, 5, 3},
+    {2, 5, 3, 0, 1, 4},
+    {0, 3, 4, 1, 2, 5},
+    {3, 0, 2, 5, 4, 1},
+    {5, 2, 1, 4, 3, 0},
+    {2, 3, 0, 1, 5, 4},
+    {1, 0, 4, 5, 2, 3},
+    {5, 4, 3, 2, 1, 0},
+    {3, 5, 4, 0, 2, 1},
+    {0, 4, 1, 2, 3, 5},
+    {3, 2, 5, 4, 0, 1},
+    {2, 0, 1, 5, 3, 4},
+    {5, 1, 4, 3, 2, 0},
+    {3, 4, 0, 2, 5, 1},
+    {1, 4, 5, 2, 0, 3},
+    {4, 0, 3, 5, 1, 2},
+    {4, 5, 1, 0, 3, 2},
+    {2, 1, 5, 3, 0, 4},
+    {4, 1, 0, 3, 5, 2},
+    {4, 3, 5, 1, 0, 2},
+};
+
+#endif /* MOVE_TABLES_H */
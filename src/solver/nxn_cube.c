@@ -0,0 +1,271 @@
+#include "nxn_cube.h"
+#include "move_tables.h"
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+
+// На слое: кольцо из n циклов плюс, для крайних слоёв, циклы самой грани
+#define NXN_MAX_CYCLES (NXN_MAX_SIZE + NXN_MAX_SIZE * NXN_MAX_SIZE / 4)
+
+// Четверть оборота слоя - набор 4-циклов: содержимое cycles[k][j] уходит в cycles[k][j + 1]
+typedef struct {
+    int count;
+    unsigned short cycles[NXN_MAX_CYCLES][4];
+} LayerCycles;
+
+static LayerCycles g_layers[NXN_MAX_SIZE + 1][6][NXN_MAX_SIZE];
+static pthread_once_t g_layers_once = PTHREAD_ONCE_INIT;
+
+static const char g_face_letters[6] = {
+    [FACE_IDX_TOP] = 'U', [FACE_IDX_FRONT] = 'F', [FACE_IDX_RIGHT] = 'R',
+    [FACE_IDX_BACK] = 'B', [FACE_IDX_LEFT] = 'L', [FACE_IDX_BOTTOM] = 'D'
+};
+
+typedef struct {
+    int v[3];
+} Vec3i;
+
+static int dot(Vec3i a, const signed char* b) {
+    return a.v[0] * b[0] + a.v[1] * b[1] + a.v[2] * b[2];
+}
+
+/*
+    Координаты удвоены, чтобы у всех наклеек они были целыми: наклейка
+    (face, row, col) сидит в n * normal + (2 * col - n + 1) * col_axis + (2 * row - n + 1) * row_axis.
+*/
+static Vec3i sticker_position(int n, int facelet, Vec3i* normal) {
+    int face = facelet / (n * n);
+    int row = (facelet / n) % n;
+    int col = facelet % n;
+    const signed char (*axes)[3] = cube_face_axes[face];
+
+    Vec3i pos;
+    for (int k = 0; k < 3; k++) {
+        pos.v[k] = n * axes[0][k] + (2 * col - n + 1) * axes[1][k] + (2 * row - n + 1) * axes[2][k];
+        normal->v[k] = axes[0][k];
+    }
+    return pos;
+}
+
+static int sticker_index(int n, Vec3i pos, Vec3i normal) {
+    for (int face = 0; face < 6; face++) {
+        const signed char (*axes)[3] = cube_face_axes[face];
+        if (dot(normal, axes[0]) != 1) continue;
+
+        int col = (dot(pos, axes[1]) + n - 1) / 2;
+        int row = (dot(pos, axes[2]) + n - 1) / 2;
+        return (face * n + row) * n + col;
+    }
+    return -1;
+}
+
+// Четверть оборота по часовой, если смотреть с конца оси: v' = -(a x v) + a (a . v)
+static Vec3i quarter_turn(Vec3i v, const signed char* a) {
+    Vec3i cross = {{a[1] * v.v[2] - a[2] * v.v[1], a[2] * v.v[0] - a[0] * v.v[2], a[0] * v.v[1] - a[1] * v.v[0]}};
+    int along = dot(v, a);
+    return (Vec3i){{-cross.v[0] + a[0] * along, -cross.v[1] + a[1] * along, -cross.v[2] + a[2] * along}};
+}
+
+// Номер слоя наклейки, считая от грани face; наклейки самой грани - слой 0, противоположной - n - 1
+static int sticker_layer(int n, Vec3i pos, int face) {
+    int d = dot(pos, cube_face_axes[face][0]);
+    if (d >= n) return 0;
+    if (d <= -n) return n - 1;
+    return (n - 1 - d) / 2;
+}
+
+static void build_layer(int n, int face, int layer, LayerCycles* out) {
+    const signed char* axis = cube_face_axes[face][0];
+    int facelets = 6 * n * n;
+    bool seen[NXN_MAX_FACELETS] = {false};
+
+    out->count = 0;
+    for (int i = 0; i < facelets; i++) {
+        Vec3i normal;
+        Vec3i pos = sticker_position(n, i, &normal);
+        if (seen[i] || sticker_layer(n, pos, face) != layer) continue;
+
+        // Орбита наклейки при четвертях оборота; центр нечётной грани стоит на месте
+        unsigned short cycle[4];
+        int length = 0;
+        int current = i;
+        do {
+            seen[current] = true;
+            if (length < 4) cycle[length] = (unsigned short)current;
+            length++;
+            pos = quarter_turn(pos, axis);
+            normal = quarter_turn(normal, axis);
+            current = sticker_index(n, pos, normal);
+        } while (current != i);
+
+        if (length == 4) {
+            memcpy(out->cycles[out->count++], cycle, sizeof(cycle));
+        }
+    }
+}
+
+static void build_layers(void) {
+    for (int n = NXN_MIN_SIZE; n <= NXN_MAX_SIZE; n++) {
+        for (int face = 0; face < 6; face++) {
+            for (int layer = 0; layer < n; layer++) {
+                build_layer(n, face, layer, &g_layers[n][face][layer]);
+            }
+        }
+    }
+}
+
+bool nxn_cube_init_solved(NxNCube* cube, int n) {
+    if (n < NXN_MIN_SIZE || n > NXN_MAX_SIZE) return false;
+
+    pthread_once(&g_layers_once, build_layers);
+    cube->n = n;
+    for (int face = 0; face < 6; face++) {
+        memset(&cube->facelets[face * n * n], face, (size_t)(n * n));
+    }
+    return true;
+}
+
+bool nxn_cube_is_solved(const NxNCube* cube) {
+    int area = cube->n * cube->n;
+    for (int face = 0; face < 6; face++) {
+        const unsigned char* stickers = &cube->facelets[face * area];
+        for (int i = 1; i < area; i++) {
+            if (stickers[i] != stickers[0]) return false;
+        }
+    }
+    return true;
+}
+
+void nxn_cube_apply_move(NxNCube* cube, NxNMove move) {
+    int q = move.quarters & 3;
+    if (q == 0) return;
+
+    unsigned char* f = cube->facelets;
+    int end = move.depth + move.width;
+    if (end > cube->n) end = cube->n;
+
+    for (int layer = move.depth; layer < end; layer++) {
+        const LayerCycles* layers = &g_layers[cube->n][move.face][layer];
+        for (int k = 0; k < layers->count; k++) {
+            const unsigned short* c = layers->cycles[k];
+            unsigned char v0 = f[c[0]], v1 = f[c[1]], v2 = f[c[2]], v3 = f[c[3]];
+            f[c[q & 3]] = v0;
+            f[c[(1 + q) & 3]] = v1;
+            f[c[(2 + q) & 3]] = v2;
+            f[c[(3 + q) & 3]] = v3;
+        }
+    }
+}
+
+int nxn_piece_facelets(int n, int facelet, int* out) {
+    // Центр кубика - на шаг внутрь от наклейки
+    Vec3i normal;
+    Vec3i pos = sticker_position(n, facelet, &normal);
+    int count = 0;
+    for (int i = 0; i < 6 * n * n && count < 3; i++) {
+        Vec3i other_normal;
+        Vec3i other = sticker_position(n, i, &other_normal);
+        bool same = true;
+        for (int k = 0; k < 3; k++) {
+            same = same && other.v[k] - other_normal.v[k] == pos.v[k] - normal.v[k];
+        }
+        if (same) out[count++] = i;
+    }
+    return count;
+}
+
+static int face_of_letter(char letter) {
+    for (int face = 0; face < 6; face++) {
+        if (g_face_letters[face] == letter) return face;
+    }
+    return -1;
+}
+
+static int read_number(const char* text, int* pos) {
+    int value = 0;
+    while (text[*pos] >= '0' && text[*pos] <= '9') {
+        value = value * 10 + (text[*pos] - '0');
+        (*pos)++;
+    }
+    return value;
+}
+
+int nxn_move_parse(const char* text, int n, NxNMove* move) {
+    int pos = 0;
+
+    // Необязательный префикс: "3" (номер слоя или ширина) или "2-3" (диапазон слоёв)
+    int first = read_number(text, &pos);
+    int last = 0;
+    if (first > 0 && text[pos] == '-') {
+        pos++;
+        last = read_number(text, &pos);
+        if (last < first) return 0;
+    }
+
+    int face = face_of_letter(text[pos]);
+    if (face < 0) return 0;
+    pos++;
+
+    bool wide = text[pos] == 'w';
+    if (wide) pos++;
+
+    int depth, width;
+    if (last > 0) {
+        if (!wide) return 0;
+        depth = first - 1;
+        width = last - first + 1;
+    } else if (wide) {
+        depth = 0;
+        width = first > 0 ? first : 2;
+    } else {
+        depth = first > 0 ? first - 1 : 0;
+        width = 1;
+    }
+    if (depth + width > n) return 0;
+
+    int quarters = 1;
+    if (text[pos] == '2') {
+        quarters = 2;
+        pos++;
+    }
+    if (text[pos] == '\'') {
+        quarters = 4 - quarters;
+        pos++;
+    }
+
+    move->face = (unsigned char)face;
+    move->depth = (unsigned char)depth;
+    move->width = (unsigned char)width;
+    move->quarters = (unsigned char)quarters;
+    return pos;
+}
+
+int nxn_move_to_string(NxNMove move, char* buffer, size_t size) {
+    const char* suffix = move.quarters == 2 ? "2" : move.quarters == 3 ? "'" : "";
+    char face = g_face_letters[move.face];
+
+    if (move.width == 1) {
+        if (move.depth == 0) return snprintf(buffer, size, "%c%s", face, suffix);
+        return snprintf(buffer, size, "%d%c%s", move.depth + 1, face, suffix);
+    }
+    if (move.depth > 0) {
+        return snprintf(buffer, size, "%d-%d%cw%s", move.depth + 1, move.depth + move.width, face, suffix);
+    }
+    if (move.width == 2) return snprintf(buffer, size, "%cw%s", face, suffix);
+    return snprintf(buffer, size, "%d%cw%s", move.width, face, suffix);
+}
+
+int nxn_cube_apply_sequence(NxNCube* cube, const char* text) {
+    int count = 0;
+    for (;;) {
+        while (*text == ' ') text++;
+        if (*text == '\0') return count;
+
+        NxNMove move;
+        int used = nxn_move_parse(text, cube->n, &move);
+        if (used == 0 || (text[used] != ' ' && text[used] != '\0')) return -1;
+        nxn_cube_apply_move(cube, move);
+        text += used;
+        count++;
+    }
+}
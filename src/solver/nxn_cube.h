@@ -0,0 +1,54 @@
+#ifndef NXN_CUBE_H
+#define NXN_CUBE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "../cube_state.h"
+
+#define NXN_MIN_SIZE 2
+#define NXN_MAX_SIZE 7
+#define NXN_MAX_FACELETS (6 * NXN_MAX_SIZE * NXN_MAX_SIZE)
+
+/*
+    Куб NxN (2x2 .. 7x7): по байту на наклейку, все грани подряд.
+    Наклейка (face, row, col) - facelets[(face * n + row) * n + col], значение -
+    номер грани, которой принадлежит её цвет в собранном кубе. Сетка каждой
+    грани та же, что у 3x3 (cube_face_axes в move_tables.h), так что при n = 3
+    раскладка совпадает с cubeColors[6][9].
+*/
+typedef struct {
+    int n;
+    unsigned char facelets[NXN_MAX_FACELETS];
+} NxNCube;
+
+/*
+    Поворот слоёв depth .. depth + width - 1, считая от грани face (0 - сама грань),
+    на quarters четвертей по часовой, если смотреть на face снаружи.
+    R = {R, 0, 1, 1}, Rw' = {R, 0, 2, 3}, внутренний слой 2R2 = {R, 1, 1, 2}.
+*/
+typedef struct {
+    unsigned char face;
+    unsigned char depth;
+    unsigned char width;
+    unsigned char quarters;
+} NxNMove;
+
+// False if n is outside NXN_MIN_SIZE..NXN_MAX_SIZE
+bool nxn_cube_init_solved(NxNCube* cube, int n);
+// Every face a single colour (in any orientation)
+bool nxn_cube_is_solved(const NxNCube* cube);
+void nxn_cube_apply_move(NxNCube* cube, NxNMove move);
+// Facelets of the piece that owns the sticker (1 for centres, 2 for edges, 3 for corners); returns the count
+int nxn_piece_facelets(int n, int facelet, int* out);
+
+/*
+    WCA notation: R, R', R2, Rw (two layers), 3Rw (three layers), 2R (second layer only).
+    Parses one move at text; returns the characters consumed, 0 if it is not a move for this size.
+*/
+int nxn_move_parse(const char* text, int n, NxNMove* move);
+// Writes the move in the same notation; returns the length written
+int nxn_move_to_string(NxNMove move, char* buffer, size_t size);
+// Applies a space-separated sequence; returns the move count or -1 at the first bad move
+int nxn_cube_apply_sequence(NxNCube* cube, const char* text);
+
+#endif /* NXN_CUBE_H */
@@ -0,0 +1,569 @@
+#include "nxn_solver.h"
+#include "cubie_cube.h"
+#include "solver_arena.h"
+#include <string.h>
+#include <pthread.h>
+
+// Однослойные ходы вокруг осей U, F, R: слой 0..n-1, 1..3 четверти
+#define NXN_LAYER_MOVES (3 * NXN_MAX_SIZE * 3)
+#define NXN_ALG_LENGTH 8
+#define NXN_ALG_MOVED 6
+#define NXN_MAX_SETUP 4
+#define NXN_DEDUP_BITS 18
+#define NXN_PARITY_ATTEMPTS 8
+
+typedef enum {
+    STICKER_CORNER,
+    STICKER_MIDDLE_EDGE, // Среднее ребро нечётного куба
+    STICKER_WING,
+    STICKER_CENTER,
+    STICKER_FIXED_CENTER // Центр грани нечётного куба, никуда не уходит с оси
+} StickerKind;
+
+/*
+    Чистый 3-цикл s [x, p t p'] s': трогает только 3 центра или 3 крыла (6 наклеек).
+    Содержимое from[k] уходит в to[k]; from отсортирован, по нему ищутся повторы.
+*/
+typedef struct {
+    unsigned char moves[NXN_ALG_LENGTH];
+    unsigned char setup[NXN_MAX_SETUP];
+    unsigned char setup_length;
+    unsigned char moved;
+    unsigned short from[NXN_ALG_MOVED];
+    unsigned short to[NXN_ALG_MOVED];
+} CycleAlg;
+
+typedef struct {
+    int n;
+    int facelets;
+    int move_count;
+    NxNMove moves[NXN_LAYER_MOVES];
+    unsigned char inverse[NXN_LAYER_MOVES];
+    unsigned short dest[NXN_LAYER_MOVES][NXN_MAX_FACELETS]; // Куда ход уносит наклейку
+    unsigned char kind[NXN_MAX_FACELETS];
+    short partner[NXN_MAX_FACELETS]; // Вторая наклейка ребра, -1 у остальных
+
+    CycleAlg* algs;
+    int alg_count;
+    int* by_target_start; // Циклы, приносящие что-то в наклейку i: by_target[start[i] .. start[i + 1])
+    int* by_target;
+} NxNTables;
+
+static NxNTables* g_tables[NXN_MAX_SIZE + 1];
+static pthread_mutex_t g_tables_lock = PTHREAD_MUTEX_INITIALIZER;
+
+static const FaceIndex g_axis_faces[3] = {FACE_IDX_TOP, FACE_IDX_FRONT, FACE_IDX_RIGHT};
+static const FaceIndex g_opposite[6] = {
+    [FACE_IDX_TOP] = FACE_IDX_BOTTOM, [FACE_IDX_BOTTOM] = FACE_IDX_TOP,
+    [FACE_IDX_FRONT] = FACE_IDX_BACK, [FACE_IDX_BACK] = FACE_IDX_FRONT,
+    [FACE_IDX_RIGHT] = FACE_IDX_LEFT, [FACE_IDX_LEFT] = FACE_IDX_RIGHT
+};
+
+static int move_axis(const NxNTables* t, int m) {
+    return m / (t->n * 3);
+}
+
+static int move_depth(const NxNTables* t, int m) {
+    return (m / 3) % t->n;
+}
+
+static bool is_outer(const NxNTables* t, int m) {
+    int depth = move_depth(t, m);
+    return depth == 0 || depth == t->n - 1;
+}
+
+static StickerKind sticker_kind(int n, int facelet) {
+    int pieces[3];
+    int count = nxn_piece_facelets(n, facelet, pieces);
+    int row = (facelet / n) % n;
+    int col = facelet % n;
+    int mid = n / 2;
+
+    if (count == 3) return STICKER_CORNER;
+    if (count == 2) {
+        bool middle = (n % 2 == 1) && (row == mid || col == mid);
+        return middle ? STICKER_MIDDLE_EDGE : STICKER_WING;
+    }
+    return (n % 2 == 1 && row == mid && col == mid) ? STICKER_FIXED_CENTER : STICKER_CENTER;
+}
+
+static unsigned long long moved_hash(const CycleAlg* alg) {
+    unsigned long long hash = 1469598103934665603ULL;
+    for (int i = 0; i < alg->moved; i++) {
+        hash ^= (unsigned long long)alg->from[i] << 16 | alg->to[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool same_cycle(const CycleAlg* a, const CycleAlg* b) {
+    return a->moved == b->moved &&
+           memcmp(a->from, b->from, a->moved * sizeof(a->from[0])) == 0 &&
+           memcmp(a->to, b->to, a->moved * sizeof(a->to[0])) == 0;
+}
+
+// Чистый ли 3-цикл у последовательности; если да - заполнить moved/from/to
+static bool classify(const NxNTables* t, CycleAlg* alg) {
+    unsigned short where[NXN_MAX_FACELETS];
+    for (int i = 0; i < t->facelets; i++) where[i] = (unsigned short)i;
+    for (int k = 0; k < NXN_ALG_LENGTH; k++) {
+        const unsigned short* dest = t->dest[alg->moves[k]];
+        for (int i = 0; i < t->facelets; i++) where[i] = dest[where[i]];
+    }
+
+    int moved = 0;
+    StickerKind kind = STICKER_CORNER;
+    for (int i = 0; i < t->facelets; i++) {
+        if (where[i] == i) continue;
+        if (moved == NXN_ALG_MOVED) return false;
+        if (moved == 0) kind = (StickerKind)t->kind[i];
+        if (t->kind[i] != kind) return false;
+        alg->from[moved] = (unsigned short)i;
+        alg->to[moved] = where[i];
+        moved++;
+    }
+
+    alg->moved = (unsigned char)moved;
+    return (kind == STICKER_CENTER && moved == 3) || (kind == STICKER_WING && moved == 6);
+}
+
+static bool add_alg(NxNTables* t, const CycleAlg* alg, int* capacity, int* dedup) {
+    unsigned long long hash = moved_hash(alg);
+    size_t slot = (size_t)(hash >> (64 - NXN_DEDUP_BITS));
+    while (dedup[slot] >= 0) {
+        if (same_cycle(&t->algs[dedup[slot]], alg)) return true;
+        slot = (slot + 1) & ((1u << NXN_DEDUP_BITS) - 1);
+    }
+    if (t->alg_count + 1 >= (1 << (NXN_DEDUP_BITS - 1))) return true;
+
+    if (t->alg_count == *capacity) {
+        int grown = *capacity ? *capacity * 2 : 1024;
+        CycleAlg* algs = solver_heap_alloc(grown * sizeof(CycleAlg));
+        if (!algs) return false;
+        if (t->alg_count > 0) memcpy(algs, t->algs, t->alg_count * sizeof(CycleAlg));
+        solver_heap_free(t->algs);
+        t->algs = algs;
+        *capacity = grown;
+    }
+    dedup[slot] = t->alg_count;
+    t->algs[t->alg_count++] = *alg;
+    return true;
+}
+
+// Тот же цикл, сопряжённый ходом m: m A m' переносит наклейку из m'(from) в m'(to)
+static CycleAlg conjugate(const NxNTables* t, const CycleAlg* alg, int m) {
+    CycleAlg result = *alg;
+    const unsigned short* back = t->dest[t->inverse[m]];
+    result.setup[0] = (unsigned char)m;
+    memcpy(&result.setup[1], alg->setup, alg->setup_length);
+    result.setup_length = (unsigned char)(alg->setup_length + 1);
+
+    for (int k = 0; k < alg->moved; k++) {
+        unsigned short from = back[alg->from[k]], to = back[alg->to[k]];
+        int j = k;
+        for (; j > 0 && result.from[j - 1] > from; j--) {
+            result.from[j] = result.from[j - 1];
+            result.to[j] = result.to[j - 1];
+        }
+        result.from[j] = from;
+        result.to[j] = to;
+    }
+    return result;
+}
+
+/*
+    Все чистые 3-циклы: сначала x p t p' x' p t' p' (x - внутренний слой,
+    p - внешний), потом их сопряжения по уровням, пока появляются новые -
+    одного хода для сопряжения на больших кубах мало.
+*/
+static bool build_algs(NxNTables* t) {
+    int* dedup = solver_heap_alloc((1u << NXN_DEDUP_BITS) * sizeof(int));
+    if (!dedup) return false;
+    memset(dedup, 0xFF, (1u << NXN_DEDUP_BITS) * sizeof(int));
+
+    int capacity = 0;
+    bool ok = true;
+    for (int x = 0; x < t->move_count && ok; x++) {
+        if (is_outer(t, x)) continue;
+        for (int p = 0; p < t->move_count && ok; p++) {
+            if (!is_outer(t, p) || move_axis(t, p) == move_axis(t, x)) continue;
+            for (int s = 0; s < t->move_count && ok; s++) {
+                if (move_axis(t, s) == move_axis(t, p)) continue;
+
+                CycleAlg alg = {.setup_length = 0};
+                const int sequence[NXN_ALG_LENGTH] = {
+                    x, p, s, t->inverse[p], t->inverse[x], p, t->inverse[s], t->inverse[p]
+                };
+                for (int k = 0; k < NXN_ALG_LENGTH; k++) alg.moves[k] = (unsigned char)sequence[k];
+                if (classify(t, &alg)) ok = add_alg(t, &alg, &capacity, dedup);
+            }
+        }
+    }
+
+    int level_start = 0;
+    for (int level = 1; level <= NXN_MAX_SETUP && ok; level++) {
+        int level_end = t->alg_count;
+        for (int a = level_start; a < level_end && ok; a++) {
+            for (int m = 0; m < t->move_count && ok; m++) {
+                // Сопряжение ходом, обратным к первому ходу подготовки, его просто сокращает
+                if (t->algs[a].setup_length > 0 && t->algs[a].setup[0] == t->inverse[m]) continue;
+                CycleAlg conjugated = conjugate(t, &t->algs[a], m);
+                ok = add_alg(t, &conjugated, &capacity, dedup);
+            }
+        }
+        level_start = level_end;
+    }
+    solver_heap_free(dedup);
+    if (!ok) return false;
+
+    t->by_target_start = solver_heap_alloc((t->facelets + 1) * sizeof(int));
+    if (!t->by_target_start) return false;
+    memset(t->by_target_start, 0, (t->facelets + 1) * sizeof(int));
+    for (int a = 0; a < t->alg_count; a++) {
+        for (int k = 0; k < t->algs[a].moved; k++) t->by_target_start[t->algs[a].to[k] + 1]++;
+    }
+    for (int i = 0; i < t->facelets; i++) t->by_target_start[i + 1] += t->by_target_start[i];
+
+    int total = t->by_target_start[t->facelets];
+    t->by_target = solver_heap_alloc((total > 0 ? total : 1) * sizeof(int));
+    if (!t->by_target) return false;
+    int fill[NXN_MAX_FACELETS];
+    memcpy(fill, t->by_target_start, t->facelets * sizeof(int));
+    for (int a = 0; a < t->alg_count; a++) {
+        for (int k = 0; k < t->algs[a].moved; k++) t->by_target[fill[t->algs[a].to[k]]++] = a;
+    }
+    return true;
+}
+
+static void destroy_tables(NxNTables* t) {
+    if (!t) return;
+    solver_heap_free(t->algs);
+    solver_heap_free(t->by_target_start);
+    solver_heap_free(t->by_target);
+    solver_heap_free(t);
+}
+
+static NxNTables* build_tables(int n) {
+    NxNTables* t = solver_heap_alloc(sizeof(NxNTables));
+    if (!t) return NULL;
+    memset(t, 0, sizeof(*t));
+    t->n = n;
+    t->facelets = 6 * n * n;
+    t->move_count = 3 * n * 3;
+
+    // Куда ход уносит наклейку - по кубу с единственной отмеченной наклейкой
+    for (int m = 0; m < t->move_count; m++) {
+        int axis = m / (n * 3), depth = (m / 3) % n, quarters = m % 3 + 1;
+        t->moves[m] = (NxNMove){(unsigned char)g_axis_faces[axis], (unsigned char)depth, 1, (unsigned char)quarters};
+        t->inverse[m] = (unsigned char)(m - (quarters - 1) + (3 - quarters));
+
+        for (int i = 0; i < t->facelets; i++) {
+            NxNCube probe;
+            nxn_cube_init_solved(&probe, n);
+            memset(probe.facelets, 0, t->facelets);
+            probe.facelets[i] = 1;
+            nxn_cube_apply_move(&probe, t->moves[m]);
+            for (int j = 0; j < t->facelets; j++) {
+                if (probe.facelets[j]) t->dest[m][i] = (unsigned short)j;
+            }
+        }
+    }
+
+    for (int i = 0; i < t->facelets; i++) {
+        t->kind[i] = (unsigned char)sticker_kind(n, i);
+        int pieces[3];
+        t->partner[i] = -1;
+        if (nxn_piece_facelets(n, i, pieces) == 2) {
+            t->partner[i] = (short)(pieces[0] == i ? pieces[1] : pieces[0]);
+        }
+    }
+
+    if (n >= 4 && !build_algs(t)) {
+        destroy_tables(t);
+        return NULL;
+    }
+    return t;
+}
+
+// Таблицы размера n строятся при первой сборке этого размера и живут до конца процесса
+static const NxNTables* get_tables(int n) {
+    pthread_mutex_lock(&g_tables_lock);
+    if (!g_tables[n]) g_tables[n] = build_tables(n);
+    const NxNTables* t = g_tables[n];
+    pthread_mutex_unlock(&g_tables_lock);
+    return t;
+}
+
+typedef struct {
+    NxNMove* moves;
+    int count;
+    int max;
+    bool overflow;
+} NxNOutput;
+
+// Ход в решение: глубокие слои записываются от противоположной грани, соседние ходы одного слоя склеиваются
+static void emit(NxNOutput* out, NxNCube* cube, NxNMove move) {
+    nxn_cube_apply_move(cube, move);
+
+    int n = cube->n;
+    if (move.depth + move.width > n - move.depth) {
+        move = (NxNMove){(unsigned char)g_opposite[move.face], (unsigned char)(n - move.depth - move.width),
+                         move.width, (unsigned char)(4 - move.quarters)};
+    }
+
+    if (out->count > 0) {
+        NxNMove* last = &out->moves[out->count - 1];
+        if (last->face == move.face && last->depth == move.depth && last->width == move.width) {
+            last->quarters = (unsigned char)((last->quarters + move.quarters) & 3);
+            if (last->quarters == 0) out->count--;
+            return;
+        }
+    }
+    if (out->count == out->max) {
+        out->overflow = true;
+        return;
+    }
+    out->moves[out->count++] = move;
+}
+
+static void emit_alg(const NxNTables* t, NxNOutput* out, NxNCube* cube, const CycleAlg* alg) {
+    for (int k = 0; k < alg->setup_length; k++) emit(out, cube, t->moves[alg->setup[k]]);
+    for (int k = 0; k < NXN_ALG_LENGTH; k++) emit(out, cube, t->moves[alg->moves[k]]);
+    for (int k = alg->setup_length - 1; k >= 0; k--) emit(out, cube, t->moves[t->inverse[alg->setup[k]]]);
+}
+
+/*
+    Поставить в sticker (и его пару, если это крыло) наклейки целевых цветов
+    одним 3-циклом, не испортив закреплённые. Циклы в таблице идут от коротких
+    к длинным, берётся первый подходящий.
+*/
+static bool place_sticker(const NxNTables* t, NxNCube* cube, const unsigned char* target, bool* locked,
+                          int sticker, NxNOutput* out) {
+    int partner = t->kind[sticker] == STICKER_WING ? t->partner[sticker] : -1;
+    locked[sticker] = true;
+    if (partner >= 0) locked[partner] = true;
+
+    if (cube->facelets[sticker] == target[sticker] && (partner < 0 || cube->facelets[partner] == target[partner])) {
+        return true;
+    }
+
+    for (int e = t->by_target_start[sticker]; e < t->by_target_start[sticker + 1]; e++) {
+        const CycleAlg* alg = &t->algs[t->by_target[e]];
+        bool fits = true;
+        for (int k = 0; k < alg->moved && fits; k++) {
+            fits = !locked[alg->to[k]] || cube->facelets[alg->from[k]] == target[alg->to[k]];
+        }
+        if (fits) {
+            emit_alg(t, out, cube, alg);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Порядок граней для центров: U, D, потом по кругу - последние две соседние
+static const FaceIndex g_center_order[6] = {
+    FACE_IDX_TOP, FACE_IDX_BOTTOM, FACE_IDX_FRONT, FACE_IDX_RIGHT, FACE_IDX_BACK, FACE_IDX_LEFT
+};
+
+static bool solve_centers(const NxNTables* t, NxNCube* cube, const unsigned char* target, NxNOutput* out) {
+    bool locked[NXN_MAX_FACELETS] = {false};
+    int area = t->n * t->n;
+    for (int k = 0; k < 6; k++) {
+        int face = g_center_order[k];
+        for (int i = face * area; i < (face + 1) * area; i++) {
+            if (t->kind[i] != STICKER_CENTER) continue;
+            if (!place_sticker(t, cube, target, locked, i, out)) return false;
+        }
+    }
+    return true;
+}
+
+// Крылья по порядку; при неудаче в *stuck - крыло, на котором застряли
+static bool solve_wings(const NxNTables* t, NxNCube* cube, const unsigned char* target, NxNOutput* out, int* stuck) {
+    bool locked[NXN_MAX_FACELETS] = {false};
+    for (int i = 0; i < t->facelets; i++) {
+        if (t->kind[i] != STICKER_WING || locked[i]) continue;
+        if (!place_sticker(t, cube, target, locked, i, out)) {
+            *stuck = i;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Внутренний слой, в котором лежит крыло: его четверть оборота меняет чётность орбиты крыльев
+static int wing_slice(const NxNTables* t, int sticker) {
+    for (int m = 0; m < t->move_count; m++) {
+        if (!is_outer(t, m) && m % 3 == 0 && t->dest[m][sticker] != sticker) return m;
+    }
+    return -1;
+}
+
+// Наклейка 3x3 (face, pos) -> наклейка NxN: середина 3x3 берётся из середины NxN
+static int skeleton_facelet(int n, int face, int pos) {
+    int map[3] = {0, (n - 1) / 2, n - 1};
+    if (n == 2 && (pos / 3 == 1 || pos % 3 == 1)) return -1; // У 2x2 нет ни рёбер, ни центров
+    return (face * n + map[pos / 3]) * n + map[pos % 3];
+}
+
+static int corner_parity(const unsigned char (*colors)[9], const int* face_of_color) {
+    int cp[CUBIE_CORNER_COUNT];
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        int mask = 0;
+        for (int k = 0; k < 3; k++) {
+            mask |= 1 << face_of_color[colors[cubie_corner_facelets[i][k][0]][cubie_corner_facelets[i][k][1]]];
+        }
+        cp[i] = -1;
+        for (int j = 0; j < CUBIE_CORNER_COUNT; j++) {
+            int home = 0;
+            for (int k = 0; k < 3; k++) home |= 1 << cubie_corner_facelets[j][k][0];
+            if (home == mask) cp[i] = j;
+        }
+        if (cp[i] < 0) return -1;
+    }
+
+    int parity = 0;
+    bool seen[CUBIE_CORNER_COUNT] = {false};
+    for (int i = 0; i < CUBIE_CORNER_COUNT; i++) {
+        if (seen[i]) continue;
+        int length = 0;
+        for (int j = i; !seen[j]; j = cp[j]) {
+            seen[j] = true;
+            length++;
+        }
+        parity ^= (length + 1) & 1;
+    }
+    return parity;
+}
+
+/*
+    Целевые цвета рёбер. Нечётный куб: крылья - под цвет среднего ребра в том
+    же месте. Чётный: на свои места, но при нечётной перестановке углов
+    рёбра UF и UB меняются местами - иначе 3x3 в конце было бы несобираемым.
+*/
+static void edge_targets(const NxNTables* t, const NxNCube* cube, const unsigned char* face_color,
+                         bool swap_uf_ub, unsigned char* target) {
+    int n = t->n;
+    int mid = n / 2;
+    for (int i = 0; i < t->facelets; i++) {
+        if (t->kind[i] != STICKER_WING) continue;
+        int face = i / (n * n);
+        int row = (i / n) % n;
+        int col = i % n;
+
+        if (n % 2 == 1) {
+            int middle = (row == 0 || row == n - 1) ? (face * n + row) * n + mid : (face * n + mid) * n + col;
+            target[i] = cube->facelets[middle];
+            continue;
+        }
+
+        target[i] = face_color[face];
+        if (!swap_uf_ub) continue;
+        int pos = (row == 0 ? 0 : row == n - 1 ? 2 : 1) * 3 + (col == 0 ? 0 : col == n - 1 ? 2 : 1);
+        for (int k = 0; k < 2; k++) {
+            // UF = ребро 0, UB = ребро 3; наклейка k у обоих на U или на боковой грани
+            int other = -1;
+            if (cubie_edge_facelets[0][k][0] == face && cubie_edge_facelets[0][k][1] == pos) other = 3;
+            if (cubie_edge_facelets[3][k][0] == face && cubie_edge_facelets[3][k][1] == pos) other = 0;
+            if (other >= 0) target[i] = face_color[cubie_edge_facelets[other][k][0]];
+        }
+    }
+}
+
+static const char g_color_letters[6] = {'W', 'R', 'B', 'O', 'G', 'Y'};
+
+// Последний этап: 3x3 из углов, средних рёбер (или достроенных) и центров - обычным решателем
+static bool solve_skeleton(SolverContext* ctx, NxNCube* cube, const unsigned char* face_color, bool swap_uf_ub,
+                           NxNOutput* out) {
+    int n = cube->n;
+    CubeState state;
+    for (int face = 0; face < 6; face++) {
+        for (int pos = 0; pos < 9; pos++) {
+            int facelet = skeleton_facelet(n, face, pos);
+            int color = face_color[face];
+            if (facelet >= 0) {
+                color = cube->facelets[facelet];
+            } else if (pos != 4 && swap_uf_ub) {
+                // Достроенные рёбра 2x2 подгоняются под чётность углов так же, как крылья
+                for (int e = 0; e < 4; e += 3) {
+                    for (int k = 0; k < 2; k++) {
+                        if (cubie_edge_facelets[e][k][0] == face && cubie_edge_facelets[e][k][1] == pos) {
+                            color = face_color[cubie_edge_facelets[3 - e][k][0]];
+                        }
+                    }
+                }
+            }
+            state.facelets[face * 9 + pos] = g_color_letters[color];
+        }
+    }
+
+    SolveResult result;
+    cube_solver_solve_state(ctx, &state, &result);
+    if (!result.solved || result.count < 0) return false;
+
+    for (int i = 0; i < result.count; i++) {
+        RotationDirection direction = move_to_direction(result.moves[i]);
+        int quarters = direction == ROTATE_CLOCKWISE ? 1 : direction == ROTATE_COUNTERCLOCKWISE ? 3 : 2;
+        emit(out, cube, (NxNMove){(unsigned char)move_to_face(result.moves[i]), 0, 1, (unsigned char)quarters});
+    }
+    return true;
+}
+
+int nxn_solve(SolverContext* ctx, const NxNCube* cube, NxNMove* out, int max_moves) {
+    int n = cube->n;
+    if (n < NXN_MIN_SIZE || n > NXN_MAX_SIZE) return -1;
+
+    const NxNTables* t = get_tables(n);
+    if (!t) return -1;
+
+    NxNCube work = *cube;
+    NxNOutput output = {out, 0, max_moves, false};
+
+    // Цвет каждой грани: у нечётного куба - по неподвижному центру, у чётного - исходная схема
+    unsigned char face_color[6];
+    int face_of_color[6] = {-1, -1, -1, -1, -1, -1};
+    for (int face = 0; face < 6; face++) {
+        int mid = n / 2;
+        face_color[face] = (n % 2 == 1) ? work.facelets[(face * n + mid) * n + mid] : (unsigned char)face;
+        if (face_color[face] > 5 || face_of_color[face_color[face]] >= 0) return -1;
+        face_of_color[face_color[face]] = face;
+    }
+
+    unsigned char target[NXN_MAX_FACELETS];
+    for (int i = 0; i < t->facelets; i++) target[i] = face_color[i / (n * n)];
+
+    // Углы не трогает ни один 3-цикл и ни один внутренний слой, их чётность известна сразу
+    static const int corner_positions[4] = {0, 2, 6, 8};
+    unsigned char corners[6][9] = {{0}};
+    for (int face = 0; face < 6; face++) {
+        for (int k = 0; k < 4; k++) {
+            corners[face][corner_positions[k]] = work.facelets[skeleton_facelet(n, face, corner_positions[k])];
+        }
+    }
+    int parity = corner_parity((const unsigned char (*)[9])corners, face_of_color);
+    if (parity < 0) return -1;
+    bool swap_uf_ub = n % 2 == 0 && parity == 1;
+
+    if (n >= 4) {
+        bool reduced = false;
+        for (int attempt = 0; attempt < NXN_PARITY_ATTEMPTS && !reduced; attempt++) {
+            if (!solve_centers(t, &work, target, &output)) return -1;
+
+            edge_targets(t, &work, face_color, swap_uf_ub, target);
+            int stuck = -1;
+            reduced = solve_wings(t, &work, target, &output, &stuck);
+            if (!reduced) {
+                // Нечётная перестановка в орбите крыльев: слой с этим крылом, центры и крылья заново
+                int slice = wing_slice(t, stuck);
+                if (slice < 0) return -1;
+                emit(&output, &work, t->moves[slice]);
+            }
+        }
+        if (!reduced) return -1;
+    }
+
+    if (!solve_skeleton(ctx, &work, face_color, swap_uf_ub, &output)) return -1;
+    if (output.overflow || !nxn_cube_is_solved(&work)) return -1;
+    return output.count;
+}
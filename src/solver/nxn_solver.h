@@ -0,0 +1,22 @@
+#ifndef NXN_SOLVER_H
+#define NXN_SOLVER_H
+
+#include "cube_solver.h"
+#include "nxn_cube.h"
+
+#define NXN_SOLVE_MAX_MOVES 4096
+
+/*
+    Сборка NxN методом редукции:
+    1. центры - чистыми 3-циклами (коммутаторы внутренних слоёв);
+    2. рёбра - так же, крылья собираются к среднему ребру (нечётный куб)
+       или прямо на свои места (чётный), паритет крыльев - поворотом слоя;
+    3. остаётся 3x3: углы, средние рёбра и центры - им занимается обычный
+       решатель на контексте ctx.
+    2x2 сразу идёт в третий этап с достроенными рёбрами.
+*/
+
+// Returns the move count (solution in out[0..count)), or -1 if the state is not solvable or does not fit
+int nxn_solve(SolverContext* ctx, const NxNCube* cube, NxNMove* out, int max_moves);
+
+#endif /* NXN_SOLVER_H */
@@ -0,0 +1,117 @@
+#include "solver_arena.h"
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#define ARENA_ALIGN 16
+
+struct SolverArenaBlock {
+    SolverArenaBlock* next;
+    // Данные идут сразу за заголовком
+};
+
+// Общий для всех потоков счётчик
+static atomic_size_t g_heap_calls = 0;
+
+void* solver_heap_alloc(size_t size) {
+    atomic_fetch_add(&g_heap_calls, 1);
+    return malloc(size);
+}
+
+void solver_heap_free(void* ptr) {
+    if (!ptr) return;
+    atomic_fetch_add(&g_heap_calls, 1);
+    free(ptr);
+}
+
+size_t solver_heap_calls(void) {
+    return atomic_load(&g_heap_calls);
+}
+
+static size_t align_up(size_t size) {
+    return (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+void solver_arena_init(SolverArena* arena) {
+    arena->base = NULL;
+    arena->capacity = 0;
+    arena->used = 0;
+    arena->overflow_bytes = 0;
+    arena->peak = 0;
+    arena->overflow = NULL;
+    arena->failed = false;
+}
+
+static void free_overflow(SolverArena* arena) {
+    while (arena->overflow) {
+        SolverArenaBlock* next = arena->overflow->next;
+        solver_heap_free(arena->overflow);
+        arena->overflow = next;
+    }
+}
+
+void solver_arena_destroy(SolverArena* arena) {
+    free_overflow(arena);
+    solver_heap_free(arena->base);
+    solver_arena_init(arena);
+}
+
+void solver_arena_reset(SolverArena* arena) {
+    free_overflow(arena);
+
+    // Прошлой сборке не хватило места - следующая получит арену с запасом
+    if (arena->peak > arena->capacity) {
+        size_t capacity = arena->capacity ? arena->capacity : SOLVER_ARENA_INITIAL_SIZE;
+        while (capacity < arena->peak) capacity *= 2;
+
+        solver_heap_free(arena->base);
+        arena->base = solver_heap_alloc(capacity);
+        arena->capacity = arena->base ? capacity : 0;
+    }
+
+    arena->used = 0;
+    arena->overflow_bytes = 0;
+    arena->peak = 0;
+    arena->failed = false;
+}
+
+static void update_peak(SolverArena* arena, size_t size) {
+    if (size > arena->peak) arena->peak = size;
+}
+
+void* solver_arena_alloc(SolverArena* arena, size_t size) {
+    size = align_up(size ? size : 1);
+
+    if (!arena->base && arena->capacity == 0) {
+        arena->base = solver_heap_alloc(SOLVER_ARENA_INITIAL_SIZE);
+        if (arena->base) arena->capacity = SOLVER_ARENA_INITIAL_SIZE;
+    }
+
+    if (arena->base && arena->used + size <= arena->capacity) {
+        void* ptr = arena->base + arena->used;
+        arena->used += size;
+        update_peak(arena, arena->used + arena->overflow_bytes);
+        return ptr;
+    }
+
+    // Размер, с которым запрос поместился бы в арену, - на него она вырастет при сбросе
+    update_peak(arena, arena->used + arena->overflow_bytes + size);
+
+    SolverArenaBlock* block = solver_heap_alloc(align_up(sizeof(SolverArenaBlock)) + size);
+    if (!block) {
+        arena->failed = true;
+        return NULL;
+    }
+    block->next = arena->overflow;
+    arena->overflow = block;
+    arena->overflow_bytes += size;
+    return (unsigned char*)block + align_up(sizeof(SolverArenaBlock));
+}
+
+size_t solver_arena_mark(const SolverArena* arena) {
+    return arena->used;
+}
+
+// Отдельные блоки живут до сброса, откатывается только сама арена
+void solver_arena_rewind(SolverArena* arena, size_t mark) {
+    if (mark < arena->used) arena->used = mark;
+}
@@ -0,0 +1,49 @@
+#ifndef SOLVER_ARENA_H
+#define SOLVER_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// Начальный размер арены; после первой сборки подстраивается под самое большое решение
+#define SOLVER_ARENA_INITIAL_SIZE (64 * 1024)
+
+typedef struct SolverArenaBlock SolverArenaBlock;
+
+/*
+    Память на время одной сборки: выделение - сдвиг указателя, освобождение -
+    solver_arena_reset() в начале следующей сборки. Если арены не хватило,
+    запрос уходит в отдельный блок, а при сбросе арена вырастает, так что
+    в установившемся режиме сборка не обращается к куче вовсе.
+*/
+typedef struct {
+    unsigned char* base;
+    size_t capacity;
+    size_t used;
+    size_t overflow_bytes; // Выделено отдельными блоками с последнего сброса
+    size_t peak;           // Наибольшее used + overflow_bytes с последнего сброса
+    SolverArenaBlock* overflow;
+    bool failed;           // Хоть один запрос с последнего сброса остался без памяти
+} SolverArena;
+
+void solver_arena_init(SolverArena* arena);
+void solver_arena_destroy(SolverArena* arena);
+
+// Frees everything allocated since the previous reset
+void solver_arena_reset(SolverArena* arena);
+
+// Uninitialised, 16-byte aligned; NULL only when the heap itself is exhausted (then failed is set)
+void* solver_arena_alloc(SolverArena* arena, size_t size);
+
+// Everything allocated after the mark is released by rewinding to it
+size_t solver_arena_mark(const SolverArena* arena);
+void solver_arena_rewind(SolverArena* arena, size_t mark);
+
+/*
+    Все обращения решателя к куче идут через эти функции и считаются.
+    Строки результата cube_solver_solve() принадлежат вызывающему и сюда не входят.
+*/
+void* solver_heap_alloc(size_t size);
+void solver_heap_free(void* ptr);
+size_t solver_heap_calls(void);
+
+#endif /* SOLVER_ARENA_H */
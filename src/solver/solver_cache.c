@@ -0,0 +1,222 @@
+#include "solver_cache.h"
+#include "solver_arena.h"
+#include "move_tables.h"
+#include <math.h>
+#include <pthread.h>
+#include <string.h>
+
+#define FACELETS MOVE_TABLES_FACELETS
+#define ROTATIONS MOVE_TABLES_ROTATIONS
+
+typedef struct {
+    unsigned long long hash;
+    unsigned long long options;
+    unsigned long long stamp; // Время последнего обращения, 0 - запись пуста
+    unsigned char count;
+    unsigned char key[SOLVER_CACHE_KEY_SIZE];
+    unsigned char moves[SOLVER_CACHE_MAX_MOVES];
+} SolverCacheEntry;
+
+struct SolverCache {
+    pthread_mutex_t lock;
+    SolverCacheEntry* entries;
+    size_t set_count; // Степень двойки
+    unsigned long long clock; // 64 бита: до переполнения (и путаницы с пустой записью) не дойдёт
+    SolverCacheStats stats;
+};
+
+static bool colors_match(RGBColor a, RGBColor b) {
+    const float tolerance = 0.1f;
+    return fabs(a.r - b.r) < tolerance &&
+           fabs(a.g - b.g) < tolerance &&
+           fabs(a.b - b.b) < tolerance;
+}
+
+static unsigned long long fnv_mix(unsigned long long hash, unsigned long long value) {
+    for (int i = 0; i < 8; i++) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Всё, от чего зависит найденное решение; потоки и размер кэша на него не влияют
+static unsigned long long options_fingerprint(const SolverOptions* options) {
+    unsigned long long hash = 1469598103934665603ULL;
+    hash = fnv_mix(hash, options->multislot);
+    hash = fnv_mix(hash, options->xcross);
+    hash = fnv_mix(hash, options->window);
+    hash = fnv_mix(hash, options->stitching);
+    hash = fnv_mix(hash, (unsigned long long)options->metric);
+    for (int i = 0; i < MOVE_EXTENDED_COUNT; i++) {
+        hash = fnv_mix(hash, options->move_cost[i]);
+    }
+    return hash;
+}
+
+void solver_cache_make_key(const RGBColor (*cubeColors)[9], const SolverOptions* options, SolverCacheKey* key) {
+    // Наклейка -> номер грани с тем же цветом центра
+    unsigned char faces[FACELETS];
+    for (int i = 0; i < FACELETS; i++) {
+        faces[i] = 0;
+        for (int f = 0; f < 6; f++) {
+            if (colors_match(cubeColors[i / 9][i % 9], cubeColors[f][4])) {
+                faces[i] = (unsigned char)f;
+                break;
+            }
+        }
+    }
+
+    for (int r = 0; r < ROTATIONS; r++) {
+        const unsigned char* src = cube_rotation_src[r];
+
+        // После поворота грани называются по тому, где теперь их центры
+        unsigned char rename[6];
+        for (int f = 0; f < 6; f++) {
+            rename[faces[src[f * 9 + 4]]] = (unsigned char)f;
+        }
+
+        unsigned char candidate[FACELETS];
+        for (int i = 0; i < FACELETS; i++) {
+            candidate[i] = rename[faces[src[i]]];
+        }
+
+        if (r == 0 || memcmp(candidate, key->key, FACELETS) < 0) {
+            memcpy(key->key, candidate, FACELETS);
+            key->rotation = (unsigned char)r;
+        }
+    }
+
+    key->options = options_fingerprint(options);
+    unsigned long long hash = key->options;
+    for (int i = 0; i < FACELETS; i++) {
+        hash ^= key->key[i];
+        hash *= 1099511628211ULL;
+    }
+    key->hash = hash;
+}
+
+// Грань face в ориентации вызывающего -> грань в канонической ориентации (и обратно)
+static FaceIndex to_canonical(int rotation, FaceIndex face) {
+    for (int f = 0; f < 6; f++) {
+        if (cube_rotation_face[rotation][f] == face) return (FaceIndex)f;
+    }
+    return face;
+}
+
+static FaceIndex from_canonical(int rotation, FaceIndex face) {
+    return (FaceIndex)cube_rotation_face[rotation][face];
+}
+
+SolverCache* solver_cache_create(size_t max_bytes) {
+    size_t entries = max_bytes / sizeof(SolverCacheEntry);
+    if (entries < SOLVER_CACHE_WAYS) return NULL;
+
+    size_t set_count = 1;
+    while (set_count * 2 * SOLVER_CACHE_WAYS <= entries) set_count *= 2;
+
+    SolverCache* cache = solver_heap_alloc(sizeof(SolverCache));
+    if (!cache) return NULL;
+    cache->entries = solver_heap_alloc(set_count * SOLVER_CACHE_WAYS * sizeof(SolverCacheEntry));
+    if (!cache->entries) {
+        solver_heap_free(cache);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < set_count * SOLVER_CACHE_WAYS; i++) {
+        cache->entries[i].stamp = 0;
+    }
+    cache->set_count = set_count;
+    cache->clock = 0;
+    memset(&cache->stats, 0, sizeof(cache->stats));
+    cache->stats.entries = set_count * SOLVER_CACHE_WAYS;
+    pthread_mutex_init(&cache->lock, NULL);
+    return cache;
+}
+
+void solver_cache_destroy(SolverCache* cache) {
+    if (!cache) return;
+    pthread_mutex_destroy(&cache->lock);
+    solver_heap_free(cache->entries);
+    solver_heap_free(cache);
+}
+
+static bool entry_matches(const SolverCacheEntry* entry, const SolverCacheKey* key) {
+    return entry->stamp != 0 && entry->hash == key->hash && entry->options == key->options &&
+           memcmp(entry->key, key->key, FACELETS) == 0;
+}
+
+static SolverCacheEntry* cache_set(SolverCache* cache, unsigned long long hash) {
+    return &cache->entries[(hash & (cache->set_count - 1)) * SOLVER_CACHE_WAYS];
+}
+
+int solver_cache_lookup(SolverCache* cache, const SolverCacheKey* key, Move* moves, int max_moves) {
+    pthread_mutex_lock(&cache->lock);
+
+    SolverCacheEntry* set = cache_set(cache, key->hash);
+    int count = -1;
+    for (int w = 0; w < SOLVER_CACHE_WAYS; w++) {
+        SolverCacheEntry* entry = &set[w];
+        if (!entry_matches(entry, key)) continue;
+        if (entry->count > max_moves) break;
+
+        entry->stamp = ++cache->clock;
+        count = entry->count;
+        for (int i = 0; i < count; i++) {
+            Move move = (Move)entry->moves[i];
+            moves[i] = get_move_from_face_and_direction(from_canonical(key->rotation, move_to_face(move)),
+                                                        move_to_direction(move));
+        }
+        break;
+    }
+
+    if (count >= 0) {
+        cache->stats.hits++;
+    } else {
+        cache->stats.misses++;
+    }
+    pthread_mutex_unlock(&cache->lock);
+    return count;
+}
+
+void solver_cache_store(SolverCache* cache, const SolverCacheKey* key, const Move* moves, int count) {
+    if (count < 0 || count > SOLVER_CACHE_MAX_MOVES) return;
+
+    pthread_mutex_lock(&cache->lock);
+
+    // Та же запись (если её успел положить другой поток), пустая или самая старая
+    SolverCacheEntry* set = cache_set(cache, key->hash);
+    SolverCacheEntry* victim = &set[0];
+    for (int w = 0; w < SOLVER_CACHE_WAYS; w++) {
+        SolverCacheEntry* entry = &set[w];
+        if (entry_matches(entry, key)) {
+            victim = entry;
+            break;
+        }
+        if (entry->stamp < victim->stamp) victim = entry;
+    }
+    if (victim->stamp != 0 && !entry_matches(victim, key)) {
+        cache->stats.evictions++;
+    }
+
+    victim->hash = key->hash;
+    victim->options = key->options;
+    victim->stamp = ++cache->clock;
+    victim->count = (unsigned char)count;
+    memcpy(victim->key, key->key, FACELETS);
+    for (int i = 0; i < count; i++) {
+        Move move = moves[i];
+        victim->moves[i] = (unsigned char)get_move_from_face_and_direction(to_canonical(key->rotation, move_to_face(move)),
+                                                                           move_to_direction(move));
+    }
+    cache->stats.stores++;
+
+    pthread_mutex_unlock(&cache->lock);
+}
+
+SolverCacheStats solver_cache_stats(SolverCache* cache) {
+    pthread_mutex_lock(&cache->lock);
+    SolverCacheStats stats = cache->stats;
+    pthread_mutex_unlock(&cache->lock);
+    return stats;
+}
@@ -0,0 +1,56 @@
+#ifndef SOLVER_CACHE_H
+#define SOLVER_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "cube_solver.h"
+
+#define SOLVER_CACHE_WAYS 8
+#define SOLVER_CACHE_KEY_SIZE 54
+// Более длинные решения не кэшируются
+#define SOLVER_CACHE_MAX_MOVES SOLVE_RESULT_MAX_MOVES
+
+typedef struct {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long stores;
+    unsigned long evictions;
+    size_t entries; // Сколько записей помещается в заданный лимит памяти
+} SolverCacheStats;
+
+/*
+    Ключ кэша - каноническое состояние: наклейки записаны номерами граней
+    (цвета не важны), из 24 поворотов всего куба берётся лексикографически
+    наименьший. Решение хранится в канонической ориентации и при выдаче
+    переводится обратно через тот же поворот, поэтому подходит любому
+    повёрнутому или перекрашенному варианту того же состояния.
+    В ключ входит и отпечаток настроек, влияющих на решение (этапы, цены
+    ходов), так что контексты с разными SolverOptions не получают чужих
+    решений из общего кэша.
+
+    Кэш множественно-ассоциативный (SOLVER_CACHE_WAYS записей в наборе,
+    вытесняется давно не использованная), один на несколько контекстов -
+    доступ под мьютексом.
+*/
+
+// NULL if max_bytes is too small for a single set
+SolverCache* solver_cache_create(size_t max_bytes);
+void solver_cache_destroy(SolverCache* cache);
+
+typedef struct {
+    unsigned char key[SOLVER_CACHE_KEY_SIZE];
+    unsigned char rotation; // Поворот, переводящий состояние в каноническое
+    unsigned long long options; // Отпечаток SolverOptions
+    unsigned long long hash;
+} SolverCacheKey;
+
+// The state must be valid (see cube_state_validate); options are the solving context's
+void solver_cache_make_key(const RGBColor (*cubeColors)[9], const SolverOptions* options, SolverCacheKey* key);
+
+// Moves are in the caller's orientation both ways; lookup returns the count or -1 on a miss
+int solver_cache_lookup(SolverCache* cache, const SolverCacheKey* key, Move* moves, int max_moves);
+void solver_cache_store(SolverCache* cache, const SolverCacheKey* key, const Move* moves, int count);
+
+SolverCacheStats solver_cache_stats(SolverCache* cache);
+
+#endif /* SOLVER_CACHE_H */
@@ -0,0 +1,261 @@
+#include "xcross.h"
+#include "solver_arena.h"
+#include <string.h>
+#include <pthread.h>
+
+// Координаты: ребро = позиция * 2 + переворот, угол = позиция * 3 + поворот
+#define XCROSS_COORDS 24
+#define XCROSS_CROSS_STATES (XCROSS_COORDS * XCROSS_COORDS * XCROSS_COORDS * XCROSS_COORDS)
+#define XCROSS_TABLE_SIZE (XCROSS_CROSS_STATES * XCROSS_COORDS)
+#define XCROSS_UNKNOWN 0xFF
+
+// Таблицы считаются для слота FRONT/RIGHT, остальные слоты приводятся к нему поворотом y
+#define XCROSS_PAIR_CORNER 1
+#define XCROSS_PAIR_EDGE 9
+
+typedef struct {
+    unsigned char edges[4]; // Рёбра креста UF, UL, UR, UB
+    unsigned char corner;
+    unsigned char edge;
+} XCrossState;
+
+static unsigned char g_edge_move[MOVE_COUNT][XCROSS_COORDS];
+static unsigned char g_corner_move[MOVE_COUNT][XCROSS_COORDS];
+static unsigned char* g_cross_corner_table = NULL;
+static unsigned char* g_cross_edge_table = NULL;
+static pthread_once_t g_tables_once = PTHREAD_ONCE_INIT;
+
+// Позиции после поворота всего куба y (правая грань становится передней)
+static int g_corner_y[CUBIE_CORNER_COUNT];
+static int g_edge_y[CUBIE_EDGE_COUNT];
+
+static int cross_index(const XCrossState* s) {
+    return ((s->edges[0] * XCROSS_COORDS + s->edges[1]) * XCROSS_COORDS + s->edges[2]) * XCROSS_COORDS + s->edges[3];
+}
+
+static void apply_move(XCrossState* s, Move move) {
+    for (int i = 0; i < 4; i++) {
+        s->edges[i] = g_edge_move[move][s->edges[i]];
+    }
+    s->corner = g_corner_move[move][s->corner];
+    s->edge = g_edge_move[move][s->edge];
+}
+
+static void init_move_tables(void) {
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        for (int pos = 0; pos < CUBIE_EDGE_COUNT; pos++) {
+            int flip_delta;
+            int dest = cubie_edge_move_dest((Move)m, pos, &flip_delta);
+            for (int flip = 0; flip < 2; flip++) {
+                g_edge_move[m][pos * 2 + flip] = (unsigned char)(dest * 2 + (flip ^ flip_delta));
+            }
+        }
+        for (int pos = 0; pos < CUBIE_CORNER_COUNT; pos++) {
+            int twist_delta;
+            int dest = cubie_corner_move_dest((Move)m, pos, &twist_delta);
+            for (int twist = 0; twist < 3; twist++) {
+                g_corner_move[m][pos * 3 + twist] = (unsigned char)(dest * 3 + (twist + twist_delta) % 3);
+            }
+        }
+    }
+
+    // y = U для верхнего слоя, D' для нижнего, средние рёбра FR -> FL -> BL -> BR -> FR
+    for (int pos = 0; pos < CUBIE_CORNER_COUNT; pos++) {
+        g_corner_y[pos] = cubie_corner_move_dest(pos < 4 ? MOVE_U : MOVE_D_PRIME, pos, NULL);
+    }
+    for (int pos = 0; pos < 8; pos++) {
+        g_edge_y[pos] = cubie_edge_move_dest(pos < 4 ? MOVE_U : MOVE_D_PRIME, pos, NULL);
+    }
+    g_edge_y[9] = 8;
+    g_edge_y[8] = 10;
+    g_edge_y[10] = 11;
+    g_edge_y[11] = 9;
+}
+
+// Поиск в ширину по слоям; piece_is_corner выбирает, какая деталь пары идёт в таблицу
+static void build_table(unsigned char* table, bool piece_is_corner) {
+    memset(table, XCROSS_UNKNOWN, XCROSS_TABLE_SIZE);
+
+    XCrossState solved = {{0, 2, 4, 6}, XCROSS_PAIR_CORNER * 3, XCROSS_PAIR_EDGE * 2};
+    int start = cross_index(&solved) * XCROSS_COORDS + (piece_is_corner ? solved.corner : solved.edge);
+    table[start] = 0;
+
+    for (int depth = 0; depth < XCROSS_UNKNOWN - 1; depth++) {
+        bool expanded = false;
+        for (int index = 0; index < XCROSS_TABLE_SIZE; index++) {
+            if (table[index] != depth) continue;
+
+            XCrossState s;
+            int rest = index;
+            int piece = rest % XCROSS_COORDS; rest /= XCROSS_COORDS;
+            for (int i = 3; i >= 0; i--) {
+                s.edges[i] = (unsigned char)(rest % XCROSS_COORDS);
+                rest /= XCROSS_COORDS;
+            }
+            s.corner = (unsigned char)piece;
+            s.edge = (unsigned char)piece;
+
+            for (int m = 0; m < MOVE_COUNT; m++) {
+                XCrossState next = s;
+                apply_move(&next, (Move)m);
+                int next_index = cross_index(&next) * XCROSS_COORDS + (piece_is_corner ? next.corner : next.edge);
+                if (table[next_index] == XCROSS_UNKNOWN) {
+                    table[next_index] = (unsigned char)(depth + 1);
+                    expanded = true;
+                }
+            }
+        }
+        if (!expanded) break;
+    }
+}
+
+static void build_tables(void) {
+    init_move_tables();
+
+    unsigned char* corner_table = solver_heap_alloc(XCROSS_TABLE_SIZE);
+    unsigned char* edge_table = solver_heap_alloc(XCROSS_TABLE_SIZE);
+    if (!corner_table || !edge_table) {
+        solver_heap_free(corner_table);
+        solver_heap_free(edge_table);
+        return;
+    }
+
+    build_table(corner_table, true);
+    build_table(edge_table, false);
+    g_cross_edge_table = edge_table;
+    g_cross_corner_table = corner_table;
+}
+
+// Таблицы строятся один раз на процесс, даже если первые сборки идут из нескольких потоков
+bool xcross_init(void) {
+    pthread_once(&g_tables_once, build_tables);
+    return g_cross_corner_table != NULL;
+}
+
+static int heuristic(const XCrossState* s) {
+    int cross = cross_index(s) * XCROSS_COORDS;
+    int a = g_cross_corner_table[cross + s->corner];
+    int b = g_cross_edge_table[cross + s->edge];
+    return a > b ? a : b;
+}
+
+static bool opposite_faces(FaceIndex a, FaceIndex b) {
+    return (a == FACE_IDX_TOP && b == FACE_IDX_BOTTOM) || (a == FACE_IDX_BOTTOM && b == FACE_IDX_TOP) ||
+           (a == FACE_IDX_FRONT && b == FACE_IDX_BACK) || (a == FACE_IDX_BACK && b == FACE_IDX_FRONT) ||
+           (a == FACE_IDX_RIGHT && b == FACE_IDX_LEFT) || (a == FACE_IDX_LEFT && b == FACE_IDX_RIGHT);
+}
+
+// Цена хода при поиске: без таблицы каждый ход - 1, бесплатных ходов граней не бывает
+static int step_cost(const unsigned char* move_cost, Move move) {
+    if (!move_cost || move_cost[move] == 0) return 1;
+    return move_cost[move];
+}
+
+/*
+    IDA* по цене: bound - цена решения, эвристика в ходах умножается на самую
+    дешёвую цену хода и остаётся допустимой. depth - число ходов в path.
+*/
+static int search(const XCrossState* s, int depth, int cost, int bound, int min_cost, const unsigned char* move_cost,
+                  int max_moves, int last_face, Move* path) {
+    int h = heuristic(s);
+    if (h == 0) return cost == bound ? depth : -1;
+    if (cost + h * min_cost > bound || depth + h > max_moves) return -1;
+
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        FaceIndex face = move_to_face((Move)m);
+        // Одна грань подряд не крутится, противоположные грани - в одном порядке
+        if ((int)face == last_face) continue;
+        if (last_face >= 0 && opposite_faces(face, last_face) && (int)face < last_face) continue;
+
+        XCrossState next = *s;
+        apply_move(&next, (Move)m);
+        path[depth] = (Move)m;
+        int found = search(&next, depth + 1, cost + step_cost(move_cost, (Move)m), bound, min_cost, move_cost,
+                           max_moves, face, path);
+        if (found >= 0) return found;
+    }
+    return -1;
+}
+
+// Состояние куба, каким его видно после поворота y^slot (слот slot становится FRONT/RIGHT)
+static XCrossState rotated_state(const CubieCube* cube, int slot) {
+    static const int slot_corner[] = {1, 3, 2, 0};
+    static const int slot_edge[] = {9, 11, 10, 8};
+
+    XCrossState s;
+    for (int i = 0; i < 4; i++) {
+        int flip;
+        int pos = cubie_edge_position(cube, i, &flip);
+        int piece = i;
+        for (int k = 0; k < slot; k++) {
+            flip ^= pos >= 8;
+            pos = g_edge_y[pos];
+            piece = g_edge_y[piece];
+        }
+        // Крестовые рёбра идут в порядке UF, UL, UR, UB, как и позиции 0..3
+        s.edges[piece] = (unsigned char)(pos * 2 + flip);
+    }
+
+    int twist;
+    int pos = cubie_corner_position(cube, slot_corner[slot], &twist);
+    for (int k = 0; k < slot; k++) {
+        pos = g_corner_y[pos];
+    }
+    s.corner = (unsigned char)(pos * 3 + twist);
+
+    int flip;
+    pos = cubie_edge_position(cube, slot_edge[slot], &flip);
+    for (int k = 0; k < slot; k++) {
+        // Меняется и позиция, и сама деталь среднего слоя - оба переворачивают ребро
+        flip ^= (pos >= 8) ^ 1;
+        pos = g_edge_y[pos];
+    }
+    s.edge = (unsigned char)(pos * 2 + flip);
+
+    return s;
+}
+
+// Ход в повёрнутом виде -> ход в исходном виде
+static Move unrotate_move(Move move, int slot) {
+    FaceIndex face = move_to_face(move);
+    if (face == FACE_IDX_TOP || face == FACE_IDX_BOTTOM) return move;
+
+    FaceIndex original = (FaceIndex)(((face - 1) + slot) % 4 + 1);
+    return get_move_from_face_and_direction(original, move_to_direction(move));
+}
+
+int xcross_solve(const CubieCube* cube, const unsigned char* move_cost, Move* out, int max_moves) {
+    if (!xcross_init()) return -1;
+    if (max_moves > XCROSS_MAX_DEPTH) max_moves = XCROSS_MAX_DEPTH;
+
+    int min_cost = step_cost(move_cost, (Move)0);
+    int max_cost = min_cost;
+    for (int m = 1; m < MOVE_COUNT; m++) {
+        int c = step_cost(move_cost, (Move)m);
+        if (c < min_cost) min_cost = c;
+        if (c > max_cost) max_cost = c;
+    }
+
+    XCrossState starts[4];
+    int min_h = XCROSS_MAX_DEPTH + 1;
+    for (int slot = 0; slot < 4; slot++) {
+        starts[slot] = rotated_state(cube, slot);
+        int h = heuristic(&starts[slot]);
+        if (h < min_h) min_h = h;
+    }
+
+    // Общая граница для всех слотов: первый найденный - самый дешёвый из четырёх
+    Move path[XCROSS_MAX_DEPTH];
+    for (int bound = min_h * min_cost; bound <= max_moves * max_cost; bound++) {
+        for (int slot = 0; slot < 4; slot++) {
+            int count = search(&starts[slot], 0, 0, bound, min_cost, move_cost, max_moves, -1, path);
+            if (count >= 0) {
+                for (int i = 0; i < count; i++) {
+                    out[i] = unrotate_move(path[i], slot);
+                }
+                return count;
+            }
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,21 @@
+#ifndef XCROSS_H
+#define XCROSS_H
+
+#include "cube_solver.h"
+#include "cubie_cube.h"
+
+#define XCROSS_MAX_DEPTH 12
+
+/*
+    Крест + первая пара F2L одним поиском (IDA*).
+    Эвристика - максимум из двух таблиц: "крест + угол пары" и "крест + ребро пары".
+    Таблицы строятся один раз: в xcross_init или при первом вызове.
+*/
+
+// Builds the pruning tables now instead of inside the first solve; false if out of memory
+bool xcross_init(void);
+
+// Cheapest XCross over all four slots (move_cost indexed by Move, NULL - every move 1); returns move count or -1
+int xcross_solve(const CubieCube* cube, const unsigned char* move_cost, Move* out, int max_moves);
+
+#endif /* XCROSS_H */
@@ -0,0 +1,267 @@
+/*
+    Микробенчмарки шагов решателя: bench_kernels [iterations] [repeats]
+
+    Каждое ядро гоняется iterations раз подряд, замер повторяется repeats
+    раз после одного прогрева; печатается среднее время операции, его
+    стандартное отклонение по повторам и лучший повтор. Входы - заранее
+    перемешанные кубы и случайные ходы, чтобы предсказатель переходов не
+    выучил один и тот же случай.
+
+    Строки состояния сцены (scene_get/set_cube_state_*) заодно перестраивают
+    меши и требуют контекст OpenGL, поэтому вместо них меряется то же
+    преобразование без сцены: cube_state_to_colors / cube_state_from_colors.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "cube_state.h"
+#include "solver/cube_solver.h"
+#include "math/rng.h"
+
+#define POOL_SIZE 64
+#define POOL_MASK (POOL_SIZE - 1)
+#define SCRAMBLE_LENGTH 25
+#define SEQUENCE_LENGTH 64
+#define MAX_REPEATS 1000
+
+typedef struct {
+    RGBColor cubes[POOL_SIZE][6][9];
+    CubeState states[POOL_SIZE];
+    Move moves[POOL_SIZE * 4];
+    Move sequences[POOL_SIZE][SEQUENCE_LENGTH];
+    RGBColor centers[6];
+    SolverContext merge_ctx;
+    SolverContext window_ctx;
+} KernelInput;
+
+typedef void (*Kernel)(KernelInput* in, long iterations);
+
+// Результаты складываются сюда, чтобы компилятор не выбросил вызовы
+static volatile long g_sink;
+
+static Rng g_rng;
+
+static unsigned int next_random(unsigned int n) {
+    return rng_below(&g_rng, n);
+}
+
+static long long now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Рёбра и углы - по граням их наклеек (цвета берутся из центров)
+static const FaceIndex edge_faces[12][2] = {
+    {FACE_IDX_TOP, FACE_IDX_FRONT}, {FACE_IDX_TOP, FACE_IDX_LEFT}, {FACE_IDX_TOP, FACE_IDX_RIGHT},
+    {FACE_IDX_TOP, FACE_IDX_BACK}, {FACE_IDX_BOTTOM, FACE_IDX_BACK}, {FACE_IDX_BOTTOM, FACE_IDX_LEFT},
+    {FACE_IDX_BOTTOM, FACE_IDX_RIGHT}, {FACE_IDX_BOTTOM, FACE_IDX_FRONT}, {FACE_IDX_FRONT, FACE_IDX_LEFT},
+    {FACE_IDX_FRONT, FACE_IDX_RIGHT}, {FACE_IDX_BACK, FACE_IDX_LEFT}, {FACE_IDX_BACK, FACE_IDX_RIGHT},
+};
+
+static const FaceIndex corner_faces[8][3] = {
+    {FACE_IDX_TOP, FACE_IDX_FRONT, FACE_IDX_LEFT}, {FACE_IDX_TOP, FACE_IDX_RIGHT, FACE_IDX_FRONT},
+    {FACE_IDX_TOP, FACE_IDX_LEFT, FACE_IDX_BACK}, {FACE_IDX_TOP, FACE_IDX_BACK, FACE_IDX_RIGHT},
+    {FACE_IDX_BOTTOM, FACE_IDX_BACK, FACE_IDX_LEFT}, {FACE_IDX_BOTTOM, FACE_IDX_RIGHT, FACE_IDX_BACK},
+    {FACE_IDX_BOTTOM, FACE_IDX_LEFT, FACE_IDX_FRONT}, {FACE_IDX_BOTTOM, FACE_IDX_FRONT, FACE_IDX_RIGHT},
+};
+
+static void init_input(KernelInput* in) {
+    rng_seed(&g_rng, 0x2545F4914F6CDD1DULL);
+    CubeState solved;
+    static const char letters[] = "WRBOGY";
+    for (int face = 0; face < 6; face++) {
+        memset(&solved.facelets[face * 9], letters[face], 9);
+    }
+
+    for (int i = 0; i < POOL_SIZE; i++) {
+        cube_state_to_colors(&solved, in->cubes[i]);
+        // Каждый восьмой куб собран - is_cube_solved проходит и до конца
+        if (i % 8 != 0) {
+            for (int k = 0; k < SCRAMBLE_LENGTH; k++) {
+                apply_move_to_cube_colors(in->cubes[i], (Move)(next_random(MOVE_COUNT)));
+            }
+        }
+        cube_state_from_colors((const RGBColor (*)[9])in->cubes[i], &in->states[i]);
+    }
+    for (int face = 0; face < 6; face++) {
+        in->centers[face] = in->cubes[0][face][4];
+    }
+    for (int i = 0; i < POOL_SIZE * 4; i++) {
+        in->moves[i] = (Move)(next_random(MOVE_COUNT));
+    }
+
+    // Последовательности с повторами граней, как сырое решение до упрощения
+    for (int i = 0; i < POOL_SIZE; i++) {
+        Move last = (Move)(next_random(MOVE_COUNT));
+        for (int k = 0; k < SEQUENCE_LENGTH; k++) {
+            if (next_random(4) != 0) last = (Move)(next_random(MOVE_COUNT));
+            in->sequences[i][k] = last;
+        }
+    }
+
+    SolverOptions options;
+    solver_options_init(&options);
+    solver_context_init(&in->merge_ctx, &options);
+    in->merge_ctx.log = NULL;
+    options.window = true;
+    solver_context_init(&in->window_ctx, &options);
+    in->window_ctx.log = NULL;
+}
+
+static void kernel_apply_move(KernelInput* in, long iterations) {
+    RGBColor cube[6][9];
+    memcpy(cube, in->cubes[1], sizeof(cube));
+    for (long i = 0; i < iterations; i++) {
+        apply_move_to_cube_colors(cube, in->moves[i & (POOL_SIZE * 4 - 1)]);
+    }
+    g_sink += (long)cube[0][0].r;
+}
+
+static void kernel_rotate_face(KernelInput* in, long iterations) {
+    static const RotationDirection directions[] = {ROTATE_CLOCKWISE, ROTATE_COUNTERCLOCKWISE, ROTATE_180};
+    RGBColor cube[6][9];
+    memcpy(cube, in->cubes[1], sizeof(cube));
+    for (long i = 0; i < iterations; i++) {
+        Move move = in->moves[i & (POOL_SIZE * 4 - 1)];
+        rotate_face_colors(cube, (FaceIndex)(move % 6), directions[move % 3]);
+    }
+    g_sink += (long)cube[0][0].r;
+}
+
+static void kernel_find_edge(KernelInput* in, long iterations) {
+    long found = 0;
+    for (long i = 0; i < iterations; i++) {
+        const FaceIndex* faces = edge_faces[i % 12];
+        FaceIndex f1, f2;
+        int p1, p2;
+        found += find_edge_piece((const RGBColor (*)[9])in->cubes[i & POOL_MASK], in->centers[faces[0]],
+                                 in->centers[faces[1]], &f1, &p1, &f2, &p2);
+    }
+    g_sink += found;
+}
+
+static void kernel_find_corner(KernelInput* in, long iterations) {
+    long found = 0;
+    for (long i = 0; i < iterations; i++) {
+        const FaceIndex* faces = corner_faces[i % 8];
+        FaceIndex f1, f2, f3;
+        int p1, p2, p3;
+        found += find_corner_piece((const RGBColor (*)[9])in->cubes[i & POOL_MASK], in->centers[faces[0]],
+                                   in->centers[faces[1]], in->centers[faces[2]], &f1, &p1, &f2, &p2, &f3, &p3);
+    }
+    g_sink += found;
+}
+
+static void kernel_is_solved(KernelInput* in, long iterations) {
+    long solved = 0;
+    for (long i = 0; i < iterations; i++) {
+        solved += is_cube_solved((const RGBColor (*)[9])in->cubes[i & POOL_MASK]);
+    }
+    g_sink += solved;
+}
+
+// Копия последовательности входит в замер: упрощение портит свой вход
+static void simplify_loop(KernelInput* in, const SolverContext* ctx, long iterations) {
+    Move moves[SEQUENCE_LENGTH];
+    MoveSequence sequence = {moves, 0, SEQUENCE_LENGTH, NULL};
+    long total = 0;
+    for (long i = 0; i < iterations; i++) {
+        memcpy(moves, in->sequences[i & POOL_MASK], sizeof(moves));
+        sequence.count = SEQUENCE_LENGTH;
+        simplify_move_sequence(ctx, &sequence);
+        total += sequence.count;
+    }
+    g_sink += total;
+}
+
+static void kernel_simplify(KernelInput* in, long iterations) {
+    simplify_loop(in, &in->merge_ctx, iterations);
+}
+
+static void kernel_simplify_window(KernelInput* in, long iterations) {
+    simplify_loop(in, &in->window_ctx, iterations);
+}
+
+static void kernel_state_to_colors(KernelInput* in, long iterations) {
+    RGBColor cube[6][9];
+    long ok = 0;
+    for (long i = 0; i < iterations; i++) {
+        ok += cube_state_to_colors(&in->states[i & POOL_MASK], cube);
+    }
+    g_sink += ok + (long)cube[0][0].r;
+}
+
+static void kernel_state_from_colors(KernelInput* in, long iterations) {
+    CubeState state;
+    long ok = 0;
+    for (long i = 0; i < iterations; i++) {
+        ok += cube_state_from_colors((const RGBColor (*)[9])in->cubes[i & POOL_MASK], &state);
+    }
+    g_sink += ok + state.facelets[0];
+}
+
+static const struct {
+    const char* name;
+    Kernel run;
+    int cost; // Во сколько раз меньше итераций, чем у остальных (тяжёлые ядра)
+} g_kernels[] = {
+    {"apply_move_to_cube_colors", kernel_apply_move, 1},
+    {"rotate_face_colors", kernel_rotate_face, 1},
+    {"find_edge_piece", kernel_find_edge, 1},
+    {"find_corner_piece", kernel_find_corner, 1},
+    {"is_cube_solved", kernel_is_solved, 1},
+    {"simplify_move_sequence", kernel_simplify, 10},
+    {"simplify_move_sequence (window)", kernel_simplify_window, 1000},
+    {"cube_state_to_colors", kernel_state_to_colors, 1},
+    {"cube_state_from_colors", kernel_state_from_colors, 1},
+};
+
+int main(int argc, char** argv) {
+    long iterations = argc > 1 ? atol(argv[1]) : 1000000;
+    int repeats = argc > 2 ? atoi(argv[2]) : 10;
+    if (iterations <= 0 || repeats <= 0 || repeats > MAX_REPEATS) {
+        fprintf(stderr, "usage: bench_kernels [iterations > 0] [repeats 1..%d]\n", MAX_REPEATS);
+        return 1;
+    }
+
+    KernelInput* in = malloc(sizeof(KernelInput));
+    if (!in) return 1;
+    init_input(in);
+
+    printf("%-34s %12s %12s %8s %12s %10s\n", "kernel", "ns/op", "stddev", "rsd", "best ns/op", "ops");
+    for (size_t k = 0; k < sizeof(g_kernels) / sizeof(g_kernels[0]); k++) {
+        long ops = iterations / g_kernels[k].cost;
+        if (ops < 1) ops = 1;
+
+        // Прогрев: таблицы, кэши и частота процессора
+        g_kernels[k].run(in, ops);
+
+        double samples[MAX_REPEATS];
+        double mean = 0.0, best = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            long long start = now_ns();
+            g_kernels[k].run(in, ops);
+            samples[r] = (double)(now_ns() - start) / ops;
+            mean += samples[r];
+            if (r == 0 || samples[r] < best) best = samples[r];
+        }
+        mean /= repeats;
+
+        double variance = 0.0;
+        for (int r = 0; r < repeats; r++) {
+            variance += (samples[r] - mean) * (samples[r] - mean);
+        }
+        double stddev = repeats > 1 ? sqrt(variance / (repeats - 1)) : 0.0;
+
+        printf("%-34s %12.2f %12.2f %7.1f%% %12.2f %10ld\n", g_kernels[k].name, mean, stddev,
+               mean > 0 ? 100.0 * stddev / mean : 0.0, best, ops);
+    }
+
+    solver_context_destroy(&in->merge_ctx);
+    solver_context_destroy(&in->window_ctx);
+    free(in);
+    return 0;
+}
@@ -0,0 +1,406 @@
+/*
+    Генератор таблиц ходов: gen_move_tables <out.h>
+
+    Из одного описания геометрии куба (нормаль и оси сетки 3x3 каждой грани,
+    грани-наклейки каждой детали) выводит перестановки наклеек для всех ходов
+    (граней, срезов, широких и поворотов куба), карты деталей, таблицы ходов
+    на уровне деталей, обратные таблицы и 24 поворота всего куба. Результат -
+    заголовок src/solver/move_tables.h.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cube_state.h"
+#include "solver/cube_solver.h"
+
+#define FACELETS 54
+#define CORNERS 8
+#define EDGES 12
+#define ROTATIONS 24
+#define MOVED 20
+
+typedef struct {
+    int x, y, z;
+} Vec;
+
+/*
+    Геометрия: x - вправо, y - вверх, z - к смотрящему (на FRONT).
+    Наклейка row * 3 + col грани лежит в normal + (col - 1) * col_axis + (row - 1) * row_axis.
+*/
+static const struct {
+    char letter;
+    Vec normal, col_axis, row_axis;
+} g_faces[6] = {
+    [FACE_IDX_TOP]    = {'U', { 0,  1,  0}, { 1, 0,  0}, {0,  0, -1}},
+    [FACE_IDX_FRONT]  = {'F', { 0,  0,  1}, { 1, 0,  0}, {0, -1,  0}},
+    [FACE_IDX_RIGHT]  = {'R', { 1,  0,  0}, { 0, 0,  1}, {0, -1,  0}},
+    [FACE_IDX_BACK]   = {'B', { 0,  0, -1}, {-1, 0,  0}, {0, -1,  0}},
+    [FACE_IDX_LEFT]   = {'L', {-1,  0,  0}, { 0, 0, -1}, {0, -1,  0}},
+    [FACE_IDX_BOTTOM] = {'D', { 0, -1,  0}, { 1, 0,  0}, {0,  0,  1}},
+};
+
+// Детали в порядке позиций cubie_cube.h; первая наклейка угла - на U или D, дальше по часовой
+static const char* g_corner_names[CORNERS] = {"UFL", "URF", "ULB", "UBR", "DBL", "DRB", "DLF", "DFR"};
+static const char* g_edge_names[EDGES] = {"UF", "UL", "UR", "UB", "DB", "DL", "DR", "DF", "FL", "FR", "BL", "BR"};
+
+/*
+    Грань, вместе с которой идёт ход, число четвертей по часовой (глядя на эту
+    грань снаружи) и слои: координата кубика вдоль нормали грани от first до last
+    (1 - сама грань, 0 - средний слой, -1 - противоположная грань).
+*/
+static const struct {
+    FaceIndex face;
+    int quarters;
+    int first, last;
+} g_moves[MOVE_EXTENDED_COUNT] = {
+    [MOVE_U] = {FACE_IDX_TOP, 1, 1, 1},    [MOVE_U_PRIME] = {FACE_IDX_TOP, 3, 1, 1},    [MOVE_U2] = {FACE_IDX_TOP, 2, 1, 1},
+    [MOVE_D] = {FACE_IDX_BOTTOM, 1, 1, 1}, [MOVE_D_PRIME] = {FACE_IDX_BOTTOM, 3, 1, 1}, [MOVE_D2] = {FACE_IDX_BOTTOM, 2, 1, 1},
+    [MOVE_F] = {FACE_IDX_FRONT, 1, 1, 1},  [MOVE_F_PRIME] = {FACE_IDX_FRONT, 3, 1, 1},  [MOVE_F2] = {FACE_IDX_FRONT, 2, 1, 1},
+    [MOVE_B] = {FACE_IDX_BACK, 1, 1, 1},   [MOVE_B_PRIME] = {FACE_IDX_BACK, 3, 1, 1},   [MOVE_B2] = {FACE_IDX_BACK, 2, 1, 1},
+    [MOVE_R] = {FACE_IDX_RIGHT, 1, 1, 1},  [MOVE_R_PRIME] = {FACE_IDX_RIGHT, 3, 1, 1},  [MOVE_R2] = {FACE_IDX_RIGHT, 2, 1, 1},
+    [MOVE_L] = {FACE_IDX_LEFT, 1, 1, 1},   [MOVE_L_PRIME] = {FACE_IDX_LEFT, 3, 1, 1},   [MOVE_L2] = {FACE_IDX_LEFT, 2, 1, 1},
+
+    [MOVE_M] = {FACE_IDX_LEFT, 1, 0, 0},   [MOVE_M_PRIME] = {FACE_IDX_LEFT, 3, 0, 0},   [MOVE_M2] = {FACE_IDX_LEFT, 2, 0, 0},
+    [MOVE_E] = {FACE_IDX_BOTTOM, 1, 0, 0}, [MOVE_E_PRIME] = {FACE_IDX_BOTTOM, 3, 0, 0}, [MOVE_E2] = {FACE_IDX_BOTTOM, 2, 0, 0},
+    [MOVE_S] = {FACE_IDX_FRONT, 1, 0, 0},  [MOVE_S_PRIME] = {FACE_IDX_FRONT, 3, 0, 0},  [MOVE_S2] = {FACE_IDX_FRONT, 2, 0, 0},
+
+    [MOVE_UW] = {FACE_IDX_TOP, 1, 0, 1},    [MOVE_UW_PRIME] = {FACE_IDX_TOP, 3, 0, 1},    [MOVE_UW2] = {FACE_IDX_TOP, 2, 0, 1},
+    [MOVE_DW] = {FACE_IDX_BOTTOM, 1, 0, 1}, [MOVE_DW_PRIME] = {FACE_IDX_BOTTOM, 3, 0, 1}, [MOVE_DW2] = {FACE_IDX_BOTTOM, 2, 0, 1},
+    [MOVE_FW] = {FACE_IDX_FRONT, 1, 0, 1},  [MOVE_FW_PRIME] = {FACE_IDX_FRONT, 3, 0, 1},  [MOVE_FW2] = {FACE_IDX_FRONT, 2, 0, 1},
+    [MOVE_BW] = {FACE_IDX_BACK, 1, 0, 1},   [MOVE_BW_PRIME] = {FACE_IDX_BACK, 3, 0, 1},   [MOVE_BW2] = {FACE_IDX_BACK, 2, 0, 1},
+    [MOVE_RW] = {FACE_IDX_RIGHT, 1, 0, 1},  [MOVE_RW_PRIME] = {FACE_IDX_RIGHT, 3, 0, 1},  [MOVE_RW2] = {FACE_IDX_RIGHT, 2, 0, 1},
+    [MOVE_LW] = {FACE_IDX_LEFT, 1, 0, 1},   [MOVE_LW_PRIME] = {FACE_IDX_LEFT, 3, 0, 1},   [MOVE_LW2] = {FACE_IDX_LEFT, 2, 0, 1},
+
+    [MOVE_X] = {FACE_IDX_RIGHT, 1, -1, 1}, [MOVE_X_PRIME] = {FACE_IDX_RIGHT, 3, -1, 1}, [MOVE_X2] = {FACE_IDX_RIGHT, 2, -1, 1},
+    [MOVE_Y] = {FACE_IDX_TOP, 1, -1, 1},   [MOVE_Y_PRIME] = {FACE_IDX_TOP, 3, -1, 1},   [MOVE_Y2] = {FACE_IDX_TOP, 2, -1, 1},
+    [MOVE_Z] = {FACE_IDX_FRONT, 1, -1, 1}, [MOVE_Z_PRIME] = {FACE_IDX_FRONT, 3, -1, 1}, [MOVE_Z2] = {FACE_IDX_FRONT, 2, -1, 1},
+};
+
+// Запись ходов; та же, что разбирает move_from_string
+static const char* g_move_names[MOVE_EXTENDED_COUNT] = {
+    "U", "U'", "U2", "D", "D'", "D2", "F", "F'", "F2", "B", "B'", "B2", "R", "R'", "R2", "L", "L'", "L2",
+    "M", "M'", "M2", "E", "E'", "E2", "S", "S'", "S2",
+    "Uw", "Uw'", "Uw2", "Dw", "Dw'", "Dw2", "Fw", "Fw'", "Fw2", "Bw", "Bw'", "Bw2", "Rw", "Rw'", "Rw2", "Lw", "Lw'", "Lw2",
+    "x", "x'", "x2", "y", "y'", "y2", "z", "z'", "z2",
+};
+
+// Положение наклейки: кубик, на котором она сидит, и направление, куда она смотрит
+typedef struct {
+    Vec cubie, normal;
+} Sticker;
+
+static Vec vec_add(Vec a, Vec b) { return (Vec){a.x + b.x, a.y + b.y, a.z + b.z}; }
+static Vec vec_scale(Vec a, int k) { return (Vec){a.x * k, a.y * k, a.z * k}; }
+static int vec_dot(Vec a, Vec b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+static int vec_equal(Vec a, Vec b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+
+static Vec vec_cross(Vec a, Vec b) {
+    return (Vec){a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+// Четверть оборота по часовой, если смотреть с конца оси (единичного вектора)
+static Vec quarter_turn(Vec v, Vec axis) {
+    return vec_add(vec_scale(vec_cross(axis, v), -1), vec_scale(axis, vec_dot(axis, v)));
+}
+
+static Sticker sticker_at(int facelet) {
+    int f = facelet / 9, row = (facelet % 9) / 3, col = facelet % 3;
+    Vec cubie = vec_add(g_faces[f].normal, vec_add(vec_scale(g_faces[f].col_axis, col - 1),
+                                                   vec_scale(g_faces[f].row_axis, row - 1)));
+    return (Sticker){cubie, g_faces[f].normal};
+}
+
+static int facelet_of(Sticker s) {
+    for (int i = 0; i < FACELETS; i++) {
+        Sticker t = sticker_at(i);
+        if (vec_equal(t.cubie, s.cubie) && vec_equal(t.normal, s.normal)) return i;
+    }
+    fprintf(stderr, "gen_move_tables: sticker outside the cube\n");
+    exit(1);
+}
+
+static int face_of_letter(char letter) {
+    for (int f = 0; f < 6; f++) {
+        if (g_faces[f].letter == letter) return f;
+    }
+    fprintf(stderr, "gen_move_tables: unknown face '%c'\n", letter);
+    exit(1);
+}
+
+// Наклейки детали по её имени: кубик - сумма нормалей граней
+static void piece_facelets(const char* name, int* out) {
+    int n = (int)strlen(name);
+    Vec cubie = {0, 0, 0};
+    for (int k = 0; k < n; k++) {
+        cubie = vec_add(cubie, g_faces[face_of_letter(name[k])].normal);
+    }
+    for (int k = 0; k < n; k++) {
+        out[k] = facelet_of((Sticker){cubie, g_faces[face_of_letter(name[k])].normal});
+    }
+}
+
+// Перестановка поворота вокруг оси axis слоёв, у которых координата вдоль оси от first до last
+static void turn_permutation(Vec axis, int quarters, int first, int last, unsigned char* src) {
+    for (int i = 0; i < FACELETS; i++) {
+        Sticker s = sticker_at(i);
+        int layer = vec_dot(s.cubie, axis);
+        if (layer < first || layer > last) {
+            src[i] = (unsigned char)i;
+            continue;
+        }
+        for (int q = 0; q < quarters; q++) {
+            s.cubie = quarter_turn(s.cubie, axis);
+            s.normal = quarter_turn(s.normal, axis);
+        }
+        // Наклейка i уходит в dest, значит в dest приходит i
+        src[facelet_of(s)] = (unsigned char)i;
+    }
+}
+
+static void compose(const unsigned char* first, const unsigned char* second, unsigned char* out) {
+    unsigned char result[FACELETS];
+    for (int i = 0; i < FACELETS; i++) result[i] = first[second[i]];
+    memcpy(out, result, FACELETS);
+}
+
+static unsigned char g_facelet_src[MOVE_EXTENDED_COUNT][FACELETS];
+static unsigned char g_facelet_moved[MOVE_COUNT][MOVED][2];
+static int g_corner_facelets[CORNERS][3];
+static int g_edge_facelets[EDGES][2];
+static unsigned char g_corner_src[MOVE_COUNT][CORNERS], g_corner_twist[MOVE_COUNT][CORNERS];
+static unsigned char g_edge_src[MOVE_COUNT][EDGES], g_edge_flip[MOVE_COUNT][EDGES];
+static unsigned char g_corner_dest[MOVE_COUNT][CORNERS], g_corner_dest_twist[MOVE_COUNT][CORNERS];
+static unsigned char g_edge_dest[MOVE_COUNT][EDGES], g_edge_dest_flip[MOVE_COUNT][EDGES];
+static unsigned char g_inverse[MOVE_EXTENDED_COUNT];
+static unsigned char g_move_face[MOVE_EXTENDED_COUNT], g_move_quarters[MOVE_EXTENDED_COUNT], g_move_layers[MOVE_EXTENDED_COUNT];
+static unsigned char g_rotation_src[ROTATIONS][FACELETS];
+static unsigned char g_rotation_face[ROTATIONS][6];
+
+static void build(void) {
+    for (int m = 0; m < MOVE_EXTENDED_COUNT; m++) {
+        turn_permutation(g_faces[g_moves[m].face].normal, g_moves[m].quarters, g_moves[m].first, g_moves[m].last,
+                         g_facelet_src[m]);
+
+        g_move_face[m] = (unsigned char)g_moves[m].face;
+        g_move_quarters[m] = (unsigned char)g_moves[m].quarters;
+        for (int layer = g_moves[m].first; layer <= g_moves[m].last; layer++) {
+            g_move_layers[m] |= (unsigned char)(1 << (1 - layer));
+        }
+
+        for (int n = 0; n < MOVE_EXTENDED_COUNT; n++) {
+            if (g_moves[n].face == g_moves[m].face && g_moves[n].first == g_moves[m].first &&
+                g_moves[n].last == g_moves[m].last && (g_moves[n].quarters + g_moves[m].quarters) % 4 == 0) {
+                g_inverse[m] = (unsigned char)n;
+            }
+        }
+    }
+
+    for (int m = 0; m < MOVE_COUNT; m++) {
+
+        // Только изменившиеся наклейки: 8 на самой грани и 12 в кольце вокруг неё
+        int moved = 0;
+        for (int i = 0; i < FACELETS; i++) {
+            if (g_facelet_src[m][i] == i) continue;
+            if (moved == MOVED) break;
+            g_facelet_moved[m][moved][0] = (unsigned char)i;
+            g_facelet_moved[m][moved][1] = g_facelet_src[m][i];
+            moved++;
+        }
+        if (moved != MOVED) {
+            fprintf(stderr, "gen_move_tables: move %d changes %d facelets instead of %d\n", m, moved, MOVED);
+            exit(1);
+        }
+    }
+
+    for (int i = 0; i < CORNERS; i++) piece_facelets(g_corner_names[i], g_corner_facelets[i]);
+    for (int i = 0; i < EDGES; i++) piece_facelets(g_edge_names[i], g_edge_facelets[i]);
+
+    // В позицию i приходит деталь, чья наклейка k оказалась на первой наклейке позиции
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        for (int i = 0; i < CORNERS; i++) {
+            int src = g_facelet_src[m][g_corner_facelets[i][0]];
+            for (int j = 0; j < CORNERS; j++) {
+                for (int k = 0; k < 3; k++) {
+                    if (g_corner_facelets[j][k] != src) continue;
+                    g_corner_src[m][i] = (unsigned char)j;
+                    g_corner_twist[m][i] = (unsigned char)((3 - k) % 3);
+                    g_corner_dest[m][j] = (unsigned char)i;
+                    g_corner_dest_twist[m][j] = (unsigned char)((3 - k) % 3);
+                }
+            }
+        }
+        for (int i = 0; i < EDGES; i++) {
+            int src = g_facelet_src[m][g_edge_facelets[i][0]];
+            for (int j = 0; j < EDGES; j++) {
+                for (int k = 0; k < 2; k++) {
+                    if (g_edge_facelets[j][k] != src) continue;
+                    g_edge_src[m][i] = (unsigned char)j;
+                    g_edge_flip[m][i] = (unsigned char)k;
+                    g_edge_dest[m][j] = (unsigned char)i;
+                    g_edge_dest_flip[m][j] = (unsigned char)k;
+                }
+            }
+        }
+    }
+
+    // Повороты всего куба - замыкание по x и y (все три слоя вокруг оси R и оси U)
+    unsigned char x[FACELETS], y[FACELETS];
+    memcpy(x, g_facelet_src[MOVE_X], FACELETS);
+    memcpy(y, g_facelet_src[MOVE_Y], FACELETS);
+
+    int count = 1;
+    for (int i = 0; i < FACELETS; i++) g_rotation_src[0][i] = (unsigned char)i;
+    for (int i = 0; i < count; i++) {
+        const unsigned char* generators[] = {x, y};
+        for (int g = 0; g < 2; g++) {
+            unsigned char next[FACELETS];
+            compose(g_rotation_src[i], generators[g], next);
+
+            int known = 0;
+            for (int j = 0; j < count && !known; j++) {
+                known = memcmp(g_rotation_src[j], next, FACELETS) == 0;
+            }
+            if (!known) memcpy(g_rotation_src[count++], next, FACELETS);
+        }
+    }
+    if (count != ROTATIONS) {
+        fprintf(stderr, "gen_move_tables: %d cube rotations instead of %d\n", count, ROTATIONS);
+        exit(1);
+    }
+    for (int r = 0; r < ROTATIONS; r++) {
+        for (int f = 0; f < 6; f++) {
+            g_rotation_face[r][f] = (unsigned char)(g_rotation_src[r][f * 9 + 4] / 9);
+        }
+    }
+}
+
+static const char* g_face_names[6] = {
+    "FACE_IDX_TOP", "FACE_IDX_FRONT", "FACE_IDX_RIGHT", "FACE_IDX_BACK", "FACE_IDX_LEFT", "FACE_IDX_BOTTOM"
+};
+
+static void emit_rows(FILE* out, const char* decl, const unsigned char* data, int rows, int cols) {
+    fprintf(out, "static const unsigned char %s = {\n", decl);
+    for (int r = 0; r < rows; r++) {
+        fprintf(out, "    {");
+        for (int c = 0; c < cols; c++) {
+            fprintf(out, "%s%d", c ? ", " : "", data[r * cols + c]);
+        }
+        fprintf(out, "},\n");
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emit_list(FILE* out, const char* decl, const unsigned char* data, int count) {
+    fprintf(out, "static const unsigned char %s = {", decl);
+    for (int i = 0; i < count; i++) {
+        fprintf(out, "%s%d", i ? ", " : "", data[i]);
+    }
+    fprintf(out, "};\n\n");
+}
+
+static void emit(FILE* out) {
+    fprintf(out, "/* Auto-generated by tools/gen_move_tables.c - DO NOT EDIT */\n\n");
+    fprintf(out, "#ifndef MOVE_TABLES_H\n#define MOVE_TABLES_H\n\n");
+    fprintf(out, "#include \"cube_solver.h\"\n\n");
+    fprintf(out, "#define MOVE_TABLES_FACELETS %d\n", FACELETS);
+    fprintf(out, "#define MOVE_TABLES_ROTATIONS %d\n", ROTATIONS);
+    fprintf(out, "#define MOVE_TABLES_MOVED %d\n\n", MOVED);
+
+    fprintf(out, "// Geometry the tables come from: outward normal, column axis, row axis of each face (x right, y up, z front)\n");
+    fprintf(out, "static const signed char cube_face_axes[6][3][3] = {\n");
+    for (int f = 0; f < 6; f++) {
+        const Vec* axes[3] = {&g_faces[f].normal, &g_faces[f].col_axis, &g_faces[f].row_axis};
+        fprintf(out, "    {");
+        for (int k = 0; k < 3; k++) {
+            fprintf(out, "%s{%d, %d, %d}", k ? ", " : "", axes[k]->x, axes[k]->y, axes[k]->z);
+        }
+        fprintf(out, "}, // %s\n", g_face_names[f]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// After move m, facelet i (face * 9 + pos) holds what was at facelet_move_src[m][i]\n");
+    emit_rows(out, "facelet_move_src[MOVE_EXTENDED_COUNT][MOVE_TABLES_FACELETS]", &g_facelet_src[0][0],
+              MOVE_EXTENDED_COUNT, FACELETS);
+
+    fprintf(out, "// For face turns: the same permutation restricted to the facelets the move changes, as {facelet, src} pairs\n");
+    fprintf(out, "static const unsigned char facelet_move_moved[MOVE_COUNT][MOVE_TABLES_MOVED][2] = {\n");
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        fprintf(out, "    {");
+        for (int k = 0; k < MOVED; k++) {
+            fprintf(out, "%s{%d, %d}", k ? ", " : "", g_facelet_moved[m][k][0], g_facelet_moved[m][k][1]);
+        }
+        fprintf(out, "},\n");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Facelet positions of each corner / edge, sticker 0 always on U or D for corners\n");
+    fprintf(out, "static const unsigned char cubie_corner_facelets[%d][3][2] = {\n", CORNERS);
+    for (int i = 0; i < CORNERS; i++) {
+        fprintf(out, "    {");
+        for (int k = 0; k < 3; k++) {
+            int f = g_corner_facelets[i][k];
+            fprintf(out, "%s{%s, %d}", k ? ", " : "", g_face_names[f / 9], f % 9);
+        }
+        fprintf(out, "}, // %s\n", g_corner_names[i]);
+    }
+    fprintf(out, "};\n\n");
+    fprintf(out, "static const unsigned char cubie_edge_facelets[%d][2][2] = {\n", EDGES);
+    for (int i = 0; i < EDGES; i++) {
+        fprintf(out, "    {");
+        for (int k = 0; k < 2; k++) {
+            int f = g_edge_facelets[i][k];
+            fprintf(out, "%s{%s, %d}", k ? ", " : "", g_face_names[f / 9], f % 9);
+        }
+        fprintf(out, "}, // %s\n", g_edge_names[i]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// After move m, position i holds the piece from src[m][i], twisted / flipped by the delta\n");
+    emit_rows(out, "cubie_corner_move_src[MOVE_COUNT][8]", &g_corner_src[0][0], MOVE_COUNT, CORNERS);
+    emit_rows(out, "cubie_corner_move_twist[MOVE_COUNT][8]", &g_corner_twist[0][0], MOVE_COUNT, CORNERS);
+    emit_rows(out, "cubie_edge_move_src[MOVE_COUNT][12]", &g_edge_src[0][0], MOVE_COUNT, EDGES);
+    emit_rows(out, "cubie_edge_move_flip[MOVE_COUNT][12]", &g_edge_flip[0][0], MOVE_COUNT, EDGES);
+
+    fprintf(out, "// Inverse tables: move m takes the piece at position p to dest[m][p]\n");
+    emit_rows(out, "cubie_corner_move_to[MOVE_COUNT][8]", &g_corner_dest[0][0], MOVE_COUNT, CORNERS);
+    emit_rows(out, "cubie_corner_move_to_twist[MOVE_COUNT][8]", &g_corner_dest_twist[0][0], MOVE_COUNT, CORNERS);
+    emit_rows(out, "cubie_edge_move_to[MOVE_COUNT][12]", &g_edge_dest[0][0], MOVE_COUNT, EDGES);
+    emit_rows(out, "cubie_edge_move_to_flip[MOVE_COUNT][12]", &g_edge_dest_flip[0][0], MOVE_COUNT, EDGES);
+
+    fprintf(out, "// Move that undoes m\n");
+    emit_list(out, "move_inverse_table[MOVE_EXTENDED_COUNT]", g_inverse, MOVE_EXTENDED_COUNT);
+    fprintf(out, "// Face each move turns along with, its clockwise quarters and layer mask (bit 0 - that face)\n");
+    emit_list(out, "move_face_table[MOVE_EXTENDED_COUNT]", g_move_face, MOVE_EXTENDED_COUNT);
+    emit_list(out, "move_quarters_table[MOVE_EXTENDED_COUNT]", g_move_quarters, MOVE_EXTENDED_COUNT);
+    emit_list(out, "move_layers_table[MOVE_EXTENDED_COUNT]", g_move_layers, MOVE_EXTENDED_COUNT);
+    fprintf(out, "static const char* const move_name_table[MOVE_EXTENDED_COUNT] = {");
+    for (int m = 0; m < MOVE_EXTENDED_COUNT; m++) {
+        fprintf(out, "%s\"%s\"", m ? ", " : "", g_move_names[m]);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "// Whole-cube rotations (identity first): facelet i takes what was at cube_rotation_src[r][i]\n");
+    emit_rows(out, "cube_rotation_src[MOVE_TABLES_ROTATIONS][MOVE_TABLES_FACELETS]", &g_rotation_src[0][0], ROTATIONS, FACELETS);
+    fprintf(out, "// Face whose center the rotation brings onto face f\n");
+    emit_rows(out, "cube_rotation_face[MOVE_TABLES_ROTATIONS][6]", &g_rotation_face[0][0], ROTATIONS, 6);
+
+    fprintf(out, "#endif /* MOVE_TABLES_H */\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <out.h>\n", argv[0]);
+        return 1;
+    }
+
+    build();
+
+    FILE* out = fopen(argv[1], "w");
+    if (!out) {
+        perror(argv[1]);
+        return 1;
+    }
+    emit(out);
+    fclose(out);
+    return 0;
+}
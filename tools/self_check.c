@@ -0,0 +1,596 @@
+/*
+    Самопроверка решателя: self_check [cubes]
+
+    Каждое решение применяется к своему скрамблу, и куб должен оказаться
+    собранным - при всех сочетаниях этапов и метрик. Программа печатает
+    проваленные проверки и возвращает 1, если провалилась хоть одна.
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "cube_state.h"
+#include "solver/cube_solver.h"
+#include "solver/cube_validate.h"
+#include "solver/cubie_cube.h"
+#include "solver/solver_cache.h"
+#include "solver/move_optimizer.h"
+#include "solver/nxn_solver.h"
+#include "math/rng.h"
+#include "benchmark/benchmark.h"
+
+#define SCRAMBLE_LENGTH 25
+#define MAX_CUBES 1000
+
+static int g_checks;
+static int g_failures;
+
+#define CHECK(condition, ...)                           \
+    do {                                                \
+        g_checks++;                                     \
+        if (!(condition)) {                             \
+            g_failures++;                               \
+            printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+            printf(__VA_ARGS__);                        \
+            printf("\n");                               \
+        }                                               \
+    } while (0)
+
+static Rng g_rng;
+
+static void solved_state(CubeState* state) {
+    static const char letters[] = "WRBOGY";
+    for (int face = 0; face < 6; face++) {
+        memset(&state->facelets[face * 9], letters[face], 9);
+    }
+}
+
+static void solved_colors(RGBColor (*cubeColors)[9]) {
+    CubeState state;
+    solved_state(&state);
+    cube_state_to_colors(&state, cubeColors);
+}
+
+// Случайные ходы граней без двух ходов одной грани подряд
+static void scramble_colors(RGBColor (*cubeColors)[9], int length) {
+    solved_colors(cubeColors);
+    int last_face = -1;
+    for (int i = 0; i < length; i++) {
+        Move move;
+        do {
+            move = (Move)rng_below(&g_rng, MOVE_COUNT);
+        } while ((int)move / 3 == last_face);
+        last_face = (int)move / 3;
+        apply_move_to_cube_colors(cubeColors, move);
+    }
+}
+
+static bool solves(const RGBColor (*scrambled)[9], const Move* moves, int count) {
+    RGBColor cube[6][9];
+    copy_cube_state(scrambled, cube);
+    for (int i = 0; i < count; i++) {
+        apply_move_to_cube_colors(cube, moves[i]);
+    }
+    return is_cube_solved((const RGBColor (*)[9])cube);
+}
+
+typedef struct {
+    const char* name;
+    bool multislot;
+    bool xcross;
+    bool window;
+    bool stitching;
+    SolverMetric metric;
+} SolverSetup;
+
+static const SolverSetup g_setups[] = {
+    {"default", false, false, false, true, SOLVER_METRIC_HTM},
+    {"no stitching", false, false, false, false, SOLVER_METRIC_HTM},
+    {"multislot", true, false, false, true, SOLVER_METRIC_HTM},
+    {"xcross", false, true, false, true, SOLVER_METRIC_HTM},
+    {"window", false, false, true, true, SOLVER_METRIC_HTM},
+    {"qtm", false, false, false, true, SOLVER_METRIC_QTM},
+    {"stm, all stages", true, true, true, true, SOLVER_METRIC_STM},
+};
+
+static void setup_options(const SolverSetup* setup, SolverOptions* options) {
+    solver_options_init(options);
+    options->multislot = setup->multislot;
+    options->xcross = setup->xcross;
+    options->window = setup->window;
+    options->stitching = setup->stitching;
+    solver_options_set_metric(options, setup->metric);
+}
+
+// Пакетный API на двух потоках: решение каждого куба применяется к его скрамблу
+static void check_batch_solves(int cubes) {
+    static RGBColor scrambled[MAX_CUBES][6][9];
+    static CubeState states[MAX_CUBES];
+    static SolveResult results[MAX_CUBES];
+
+    for (int i = 0; i < cubes; i++) {
+        scramble_colors(scrambled[i], i == 0 ? 0 : SCRAMBLE_LENGTH);
+        cube_state_from_colors((const RGBColor (*)[9])scrambled[i], &states[i]);
+    }
+
+    for (size_t s = 0; s < sizeof(g_setups) / sizeof(g_setups[0]); s++) {
+        SolverOptions options;
+        setup_options(&g_setups[s], &options);
+        options.threads = 2;
+        CHECK(cube_solver_solve_batch(states, (size_t)cubes, results, &options) == 0, "%s: batch failed",
+              g_setups[s].name);
+
+        for (int i = 0; i < cubes; i++) {
+            const SolveResult* result = &results[i];
+            CHECK(result->solved && result->count >= 0, "%s: cube %d not solved", g_setups[s].name, i);
+            if (result->count < 0) continue;
+            CHECK(solves((const RGBColor (*)[9])scrambled[i], result->moves, result->count),
+                  "%s: cube %d: solution does not solve the scramble", g_setups[s].name, i);
+        }
+    }
+}
+
+static bool same_result(const SolveResult* a, const SolveResult* b) {
+    if (a->solved != b->solved || a->count != b->count) return false;
+    return a->count <= 0 || memcmp(a->moves, b->moves, a->count * sizeof(Move)) == 0;
+}
+
+// С общим кэшем пакет на одном и на нескольких потоках даёт одни и те же решения
+static void check_batch_cache(int cubes) {
+    static CubeState states[2 * MAX_CUBES];
+    static SolveResult serial[2 * MAX_CUBES];
+    static SolveResult threaded[2 * MAX_CUBES];
+
+    // Вторая половина повторяет первую (через раз повёрнутой), повторы далеко от оригиналов
+    int distinct = cubes < 300 ? 300 : cubes;
+    for (int i = 0; i < distinct; i++) {
+        RGBColor cube[6][9];
+        scramble_colors(cube, SCRAMBLE_LENGTH);
+        cube_state_from_colors((const RGBColor (*)[9])cube, &states[i]);
+        if (i % 2) {
+            apply_move_to_cube_colors(cube, MOVE_X);
+            apply_move_to_cube_colors(cube, MOVE_Y_PRIME);
+        }
+        cube_state_from_colors((const RGBColor (*)[9])cube, &states[distinct + i]);
+    }
+
+    SolverOptions options;
+    solver_options_init(&options);
+    options.cache_bytes = 1 << 20;
+    options.threads = 1;
+    CHECK(cube_solver_solve_batch(states, 2 * distinct, serial, &options) == 0, "batch cache: serial batch failed");
+    options.threads = 4;
+    CHECK(cube_solver_solve_batch(states, 2 * distinct, threaded, &options) == 0, "batch cache: threaded batch failed");
+
+    for (int i = 0; i < 2 * distinct; i++) {
+        CHECK(serial[i].solved, "batch cache: cube %d not solved", i);
+        CHECK(same_result(&serial[i], &threaded[i]), "batch cache: cube %d differs between 1 and 4 threads", i);
+    }
+}
+
+// Строковый API (как у сцены): имена ходов разбираются обратно и применяются
+static void check_string_solves(int cubes) {
+    SolverOptions options;
+    solver_options_init(&options);
+    SolverContext ctx;
+    solver_context_init(&ctx, &options);
+    ctx.log = NULL;
+
+    for (int i = 0; i < cubes; i++) {
+        RGBColor cube[6][9];
+        scramble_colors(cube, SCRAMBLE_LENGTH);
+
+        bool solved = false;
+        char** sequence = cube_solver_solve_ctx(&ctx, (const RGBColor (*)[9])cube, &solved);
+        CHECK(sequence && solved, "cube %d: cube_solver_solve_ctx did not solve", i);
+        if (!sequence) continue;
+
+        for (int k = 0; sequence[k]; k++) {
+            Move move;
+            CHECK(move_from_string(sequence[k], &move), "cube %d: bad move name %s", i, sequence[k]);
+            apply_move_to_cube_colors(cube, move);
+            free(sequence[k]);
+        }
+        free(sequence);
+        CHECK(is_cube_solved((const RGBColor (*)[9])cube), "cube %d: move names do not solve the scramble", i);
+    }
+    solver_context_destroy(&ctx);
+}
+
+static bool same_colors(const RGBColor (*a)[9], const RGBColor (*b)[9]) {
+    CubeState sa, sb;
+    return cube_state_from_colors(a, &sa) && cube_state_from_colors(b, &sb) &&
+           memcmp(sa.facelets, sb.facelets, sizeof(sa.facelets)) == 0;
+}
+
+// Модель деталей идёт в ногу с наклейками на тех же ходах и переводится туда и обратно без потерь
+static void check_cubie_model(int cubes) {
+    for (int i = 0; i < cubes; i++) {
+        RGBColor cube[6][9];
+        solved_colors(cube);
+        CubieCube cubie;
+        cubie_cube_init_solved(&cubie);
+
+        for (int k = 0; k < SCRAMBLE_LENGTH; k++) {
+            Move move = (Move)rng_below(&g_rng, MOVE_COUNT);
+            apply_move_to_cube_colors(cube, move);
+            cubie_cube_apply_move(&cubie, move);
+        }
+
+        CubieCube read;
+        CHECK(cubie_cube_from_colors(&read, (const RGBColor (*)[9])cube), "cubie: cube %d not readable", i);
+        CHECK(memcmp(&read, &cubie, sizeof(cubie)) == 0, "cubie: cube %d differs from the sticker model", i);
+
+        RGBColor written[6][9];
+        solved_colors(written);
+        cubie_cube_to_colors(&cubie, written);
+        CHECK(same_colors((const RGBColor (*)[9])written, (const RGBColor (*)[9])cube),
+              "cubie: cube %d does not round-trip through cubie_cube_to_colors", i);
+    }
+}
+
+// Сгенерированные таблицы ходов: обратный ход отменяет ход, имена разбираются обратно
+static void check_move_tables(void) {
+    RGBColor scrambled[6][9];
+    scramble_colors(scrambled, SCRAMBLE_LENGTH);
+
+    for (int m = 0; m < MOVE_EXTENDED_COUNT; m++) {
+        Move move = (Move)m;
+        RGBColor cube[6][9];
+        copy_cube_state((const RGBColor (*)[9])scrambled, cube);
+        apply_move_to_cube_colors(cube, move);
+        CHECK(!same_colors((const RGBColor (*)[9])cube, (const RGBColor (*)[9])scrambled),
+              "move %s changes nothing", move_to_string(move));
+        apply_move_to_cube_colors(cube, move_inverse(move));
+        CHECK(same_colors((const RGBColor (*)[9])cube, (const RGBColor (*)[9])scrambled),
+              "move %s is not undone by %s", move_to_string(move), move_to_string(move_inverse(move)));
+
+        // Четыре раза - тождество для любого хода
+        for (int k = 0; k < 4; k++) {
+            apply_move_to_cube_colors(cube, move);
+        }
+        CHECK(same_colors((const RGBColor (*)[9])cube, (const RGBColor (*)[9])scrambled),
+              "move %s applied four times is not the identity", move_to_string(move));
+
+        Move parsed;
+        CHECK(move_from_string(move_to_string(move), &parsed) && parsed == move, "move %s does not parse back",
+              move_to_string(move));
+    }
+}
+
+#define OPTIMIZER_SEQUENCE 40
+
+static void apply_moves(RGBColor (*cubeColors)[9], const Move* moves, int count) {
+    for (int i = 0; i < count; i++) {
+        apply_move_to_cube_colors(cubeColors, moves[i]);
+    }
+}
+
+// Оптимизатор не меняет действие последовательности и не удлиняет её
+static void check_move_optimizer(int cubes) {
+    Move known[] = {MOVE_R, MOVE_L, MOVE_R_PRIME};
+    CHECK(move_optimizer_merge(known, 3) == 1 && known[0] == MOVE_L, "merge: R L R' is not L");
+
+    for (int i = 0; i < cubes; i++) {
+        // Много повторов граней, как в сыром решении; каждая пятая - со срезами и поворотами
+        Move moves[OPTIMIZER_SEQUENCE];
+        Move last = MOVE_U;
+        int range = i % 5 == 0 ? MOVE_EXTENDED_COUNT : MOVE_COUNT;
+        for (int k = 0; k < OPTIMIZER_SEQUENCE; k++) {
+            if (rng_below(&g_rng, 3) != 0) last = (Move)rng_below(&g_rng, (unsigned int)range);
+            moves[k] = last;
+        }
+
+        RGBColor expected[6][9];
+        solved_colors(expected);
+        apply_moves(expected, moves, OPTIMIZER_SEQUENCE);
+
+        int merged = move_optimizer_merge(moves, OPTIMIZER_SEQUENCE);
+        RGBColor cube[6][9];
+        solved_colors(cube);
+        apply_moves(cube, moves, merged);
+        CHECK(merged <= OPTIMIZER_SEQUENCE, "merge: sequence %d grew to %d moves", i, merged);
+        CHECK(same_colors((const RGBColor (*)[9])cube, (const RGBColor (*)[9])expected),
+              "merge: sequence %d changed its effect", i);
+
+        int windowed = move_optimizer_window(moves, merged, NULL);
+        solved_colors(cube);
+        apply_moves(cube, moves, windowed);
+        CHECK(windowed <= merged, "window: sequence %d grew from %d to %d moves", i, merged, windowed);
+        CHECK(same_colors((const RGBColor (*)[9])cube, (const RGBColor (*)[9])expected),
+              "window: sequence %d changed its effect", i);
+    }
+}
+
+#define NXN_SCRAMBLE_LENGTH 60
+
+// Редукция на каждом размере: решение применяется к скрамблу, имена ходов разбираются обратно
+static void check_nxn(int cubes) {
+    static NxNMove solution[NXN_SOLVE_MAX_MOVES];
+    SolverOptions options;
+    solver_options_init(&options);
+    SolverContext ctx;
+    solver_context_init(&ctx, &options);
+    ctx.log = NULL;
+
+    for (int n = NXN_MIN_SIZE; n <= NXN_MAX_SIZE; n++) {
+        int count = cubes / 10 > 0 ? cubes / 10 : 1;
+        for (int i = 0; i < count; i++) {
+            NxNCube cube;
+            nxn_cube_init_solved(&cube, n);
+            for (int k = 0; k < NXN_SCRAMBLE_LENGTH; k++) {
+                NxNMove move;
+                move.face = (unsigned char)rng_below(&g_rng, 6);
+                move.depth = (unsigned char)rng_below(&g_rng, (unsigned int)(n / 2));
+                move.width = 1;
+                move.quarters = (unsigned char)(1 + rng_below(&g_rng, 3));
+                nxn_cube_apply_move(&cube, move);
+
+                char name[16];
+                NxNMove parsed;
+                nxn_move_to_string(move, name, sizeof(name));
+                CHECK(nxn_move_parse(name, n, &parsed) == (int)strlen(name) && parsed.face == move.face &&
+                          parsed.depth == move.depth && parsed.width == move.width &&
+                          parsed.quarters == move.quarters,
+                      "nxn %d: move %s does not parse back", n, name);
+            }
+
+            int moves = nxn_solve(&ctx, &cube, solution, NXN_SOLVE_MAX_MOVES);
+            CHECK(moves >= 0, "nxn %d: cube %d not solved", n, i);
+            for (int k = 0; k < moves; k++) {
+                nxn_cube_apply_move(&cube, solution[k]);
+            }
+            CHECK(moves < 0 || nxn_cube_is_solved(&cube), "nxn %d: solution of cube %d does not solve it", n, i);
+        }
+    }
+    solver_context_destroy(&ctx);
+}
+
+#define COMPARE_BASE_CSV "self_check_base.csv"
+#define COMPARE_CURRENT_CSV "self_check_current.csv"
+
+// Ходы одинаковы в обоих файлах (кроме moves_extra), время - scale * 900..1100 нс случайно
+static bool write_bench_csv(const char* path, int runs, double scale, int moves_extra, unsigned int seed) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) return false;
+    fprintf(fp, "run,moves,solved,cost,solve_ns,seed,scramble\n");
+    for (int r = 1; r <= runs; r++) {
+        int moves = 55 + r % 10 + moves_extra;
+        long long ns = (long long)(scale * (900 + rng_below(&g_rng, 200)));
+        fprintf(fp, "%d,%d,1,%d,%lld,%u,%d\n", r, moves, moves, ns, seed, SCRAMBLE_LENGTH);
+    }
+    fclose(fp);
+    return true;
+}
+
+// compare_benchmark на синтетических CSV: 0 - без регрессии, 3 - регрессия, 2 - ошибка чтения
+static void check_compare(void) {
+    struct {
+        const char* name;
+        int base_runs, current_runs;
+        double current_scale;
+        int current_moves_extra;
+        unsigned int current_seed;
+        int expected;
+    } cases[] = {
+        {"same distribution", 200, 200, 1.0, 0, 1, 0},
+        {"slower solves", 200, 200, 1.5, 0, 1, 3},
+        {"longer solutions", 200, 200, 1.0, 10, 1, 3},
+        {"one run per file", 1, 1, 1.0, 0, 1, 0},
+        // Другие скрамблы: ходы не сравниваются, и больше ходов - не регрессия
+        {"different seeds", 200, 200, 1.0, 10, 2, 0},
+    };
+
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        bool written = write_bench_csv(COMPARE_BASE_CSV, cases[c].base_runs, 1.0, 0, 1) &&
+                       write_bench_csv(COMPARE_CURRENT_CSV, cases[c].current_runs, cases[c].current_scale,
+                                       cases[c].current_moves_extra, cases[c].current_seed);
+        CHECK(written, "compare %s: cannot write CSV files", cases[c].name);
+        if (!written) continue;
+        int rc = compare_benchmark(COMPARE_BASE_CSV, COMPARE_CURRENT_CSV, 2.0);
+        CHECK(rc == cases[c].expected, "compare %s: returned %d, expected %d", cases[c].name, rc,
+              cases[c].expected);
+    }
+
+    remove(COMPARE_CURRENT_CSV);
+    CHECK(compare_benchmark(COMPARE_BASE_CSV, COMPARE_CURRENT_CSV, 2.0) == 2, "compare: missing file not reported");
+    remove(COMPARE_BASE_CSV);
+}
+
+// Эталонные значения xoshiro256** для состояния {1, 2, 3, 4}; после прыжка - посчитаны возведением
+// матрицы перехода над GF(2) в степень 2^128, независимо от rng_jump
+static void check_rng(void) {
+    static const unsigned long long expected[] = {11520ULL, 0ULL, 1509978240ULL, 1215971899390074240ULL};
+    Rng rng = {{1, 2, 3, 4}};
+    for (int i = 0; i < 4; i++) {
+        unsigned long long value = rng_next(&rng);
+        CHECK(value == expected[i], "rng: output %d is %llu, expected %llu", i, value, expected[i]);
+    }
+
+    static const unsigned long long jumped[4] = {
+        0x8C7A153956B5F3D1ULL, 0x701F1A713401D85EULL, 0x6527F66A65469085ULL, 0x8386B786C4408050ULL
+    };
+    Rng parent = {{1, 2, 3, 4}};
+    Rng child = rng_split(&parent);
+    CHECK(memcmp(child.s, (unsigned long long[4]){1, 2, 3, 4}, sizeof(child.s)) == 0,
+          "rng: split child does not continue the parent stream");
+    CHECK(memcmp(parent.s, jumped, sizeof(jumped)) == 0, "rng: jump state differs from the reference");
+    CHECK(rng_next(&parent) == 13534147089533256664ULL, "rng: first output after a jump differs from the reference");
+
+    Rng a, b;
+    rng_seed_stream(&a, 7, 3);
+    rng_seed_stream(&b, 7, 3);
+    CHECK(rng_next(&a) == rng_next(&b), "rng: the same seed and stream give different numbers");
+    rng_seed_stream(&b, 7, 4);
+    CHECK(rng_next(&a) != rng_next(&b), "rng: neighbouring streams coincide");
+
+    // Границы и грубая равномерность rng_below
+    int counts[7] = {0};
+    bool in_range = true;
+    for (int i = 0; i < 70000; i++) {
+        unsigned int value = rng_below(&a, 7);
+        if (value < 7) {
+            counts[value]++;
+        } else {
+            in_range = false;
+        }
+    }
+    CHECK(in_range, "rng: rng_below(7) went out of range");
+    for (int i = 0; i < 7; i++) {
+        CHECK(counts[i] > 9500 && counts[i] < 10500, "rng: value %d drawn %d times of 70000", i, counts[i]);
+    }
+}
+
+static void swap_facelets(RGBColor (*cubeColors)[9], const unsigned char* a, const unsigned char* b) {
+    RGBColor t = cubeColors[a[0]][a[1]];
+    cubeColors[a[0]][a[1]] = cubeColors[b[0]][b[1]];
+    cubeColors[b[0]][b[1]] = t;
+}
+
+static void check_validate(const char* name, const RGBColor (*cubeColors)[9], CubeStateError expected) {
+    CubeStateError error = cube_state_validate(cubeColors);
+    CHECK(error == expected, "validate %s: got %s, expected %s", name, cube_state_error_string(error),
+          cube_state_error_string(expected));
+}
+
+// Каждая ошибка валидатора на кубе, где нарушено только то, что она проверяет
+static void check_validator(void) {
+    RGBColor cube[6][9];
+    solved_colors(cube);
+    check_validate("solved", (const RGBColor (*)[9])cube, CUBE_STATE_VALID);
+    for (int i = 0; i < 20; i++) {
+        scramble_colors(cube, SCRAMBLE_LENGTH);
+        check_validate("scrambled", (const RGBColor (*)[9])cube, CUBE_STATE_VALID);
+    }
+
+    solved_colors(cube);
+    cube[FACE_IDX_FRONT][4] = cube[FACE_IDX_TOP][4];
+    check_validate("duplicate centre", (const RGBColor (*)[9])cube, CUBE_STATE_DUPLICATE_CENTER);
+
+    solved_colors(cube);
+    cube[FACE_IDX_TOP][0] = (RGBColor){0.5f, 0.0f, 0.5f};
+    check_validate("unknown colour", (const RGBColor (*)[9])cube, CUBE_STATE_UNKNOWN_COLOR);
+
+    solved_colors(cube);
+    cube[FACE_IDX_TOP][0] = cube[FACE_IDX_FRONT][4];
+    check_validate("colour count", (const RGBColor (*)[9])cube, CUBE_STATE_WRONG_COLOR_COUNT);
+
+    // Обмен наклеек между двумя деталями сохраняет число цветов, но даёт угол (ребро) с двумя белыми
+    solved_colors(cube);
+    swap_facelets(cube, cubie_corner_facelets[0][2], cubie_corner_facelets[1][0]);
+    check_validate("corner", (const RGBColor (*)[9])cube, CUBE_STATE_INVALID_CORNER);
+
+    solved_colors(cube);
+    swap_facelets(cube, cubie_edge_facelets[0][1], cubie_edge_facelets[3][0]);
+    check_validate("edge", (const RGBColor (*)[9])cube, CUBE_STATE_INVALID_EDGE);
+
+    CubieCube cubie;
+    cubie_cube_init_solved(&cubie);
+    cubie.co[0] = 1;
+    solved_colors(cube);
+    cubie_cube_to_colors(&cubie, cube);
+    check_validate("twisted corner", (const RGBColor (*)[9])cube, CUBE_STATE_TWISTED_CORNER);
+
+    cubie_cube_init_solved(&cubie);
+    cubie.eo[0] = 1;
+    cubie_cube_to_colors(&cubie, cube);
+    check_validate("flipped edge", (const RGBColor (*)[9])cube, CUBE_STATE_FLIPPED_EDGE);
+
+    cubie_cube_init_solved(&cubie);
+    cubie.ep[0] = 1;
+    cubie.ep[1] = 0;
+    cubie_cube_to_colors(&cubie, cube);
+    check_validate("parity", (const RGBColor (*)[9])cube, CUBE_STATE_PARITY);
+
+    // Решатель отказывается от несобираемого состояния, а не выдаёт что-то
+    SolverOptions options;
+    solver_options_init(&options);
+    SolverContext ctx;
+    solver_context_init(&ctx, &options);
+    ctx.log = NULL;
+    CubeState state;
+    SolveResult result;
+    cube_state_from_colors((const RGBColor (*)[9])cube, &state);
+    cube_solver_solve_state(&ctx, &state, &result);
+    CHECK(!result.solved, "parity state reported as solved");
+    solver_context_destroy(&ctx);
+}
+
+static bool solve_colors(SolverContext* ctx, const RGBColor (*cubeColors)[9], SolveResult* result) {
+    CubeState state;
+    cube_state_from_colors(cubeColors, &state);
+    cube_solver_solve_state(ctx, &state, result);
+    return result->solved && result->count >= 0 && solves(cubeColors, result->moves, result->count);
+}
+
+/*
+    Повёрнутый куб - то же каноническое состояние: второй раз решение берётся
+    из кэша и переводится в ориентацию вызывающего. Контекст с другими
+    настройками на том же кэше чужого решения получить не должен.
+*/
+static void check_cache(int cubes) {
+    SolverOptions options;
+    solver_options_init(&options);
+    options.cache_bytes = 1 << 20;
+    SolverContext ctx;
+    solver_context_init(&ctx, &options);
+    ctx.log = NULL;
+
+    SolverOptions other_options;
+    solver_options_init(&other_options);
+    solver_options_set_metric(&other_options, SOLVER_METRIC_QTM);
+    other_options.multislot = true;
+    SolverContext other;
+    solver_context_init(&other, &other_options);
+    other.log = NULL;
+    other.cache = ctx.cache;
+
+    CHECK(ctx.cache != NULL, "cache was not created");
+    if (!ctx.cache) return;
+
+    for (int i = 0; i < cubes; i++) {
+        RGBColor cube[6][9];
+        scramble_colors(cube, SCRAMBLE_LENGTH);
+        SolveResult result;
+        CHECK(solve_colors(&ctx, (const RGBColor (*)[9])cube, &result), "cache: cube %d not solved", i);
+
+        SolverCacheStats before = solver_cache_stats(ctx.cache);
+        apply_move_to_cube_colors(cube, MOVE_X);
+        apply_move_to_cube_colors(cube, MOVE_Y_PRIME);
+        CHECK(solve_colors(&ctx, (const RGBColor (*)[9])cube, &result), "cache: rotated cube %d not solved", i);
+        SolverCacheStats after = solver_cache_stats(ctx.cache);
+        CHECK(after.hits == before.hits + 1, "cache: rotated cube %d missed the cache", i);
+
+        before = after;
+        CHECK(solve_colors(&other, (const RGBColor (*)[9])cube, &result), "cache: cube %d not solved (qtm)", i);
+        after = solver_cache_stats(ctx.cache);
+        CHECK(after.hits == before.hits, "cache: cube %d hit a solution made with other options", i);
+    }
+
+    other.cache = NULL;
+    solver_context_destroy(&other);
+    solver_context_destroy(&ctx);
+}
+
+int main(int argc, char** argv) {
+    int cubes = argc > 1 ? atoi(argv[1]) : 100;
+    if (cubes <= 0 || cubes > MAX_CUBES) {
+        fprintf(stderr, "usage: self_check [cubes 1..%d]\n", MAX_CUBES);
+        return 1;
+    }
+    check_rng();
+    rng_seed(&g_rng, 20240601ULL);
+
+    check_batch_solves(cubes);
+    check_batch_cache(cubes);
+    check_string_solves(cubes);
+    check_cubie_model(cubes);
+    check_move_tables();
+    check_move_optimizer(cubes);
+    check_nxn(cubes);
+    check_validator();
+    check_cache(cubes);
+    check_compare();
+
+    printf("%d checks, %d failed\n", g_checks, g_failures);
+    return g_failures == 0 ? 0 : 1;
+}